@@ -0,0 +1,189 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit_bench.c
+ * \brief Throughput benchmark for binary raster operations.
+ * \details Sweeps every binary raster operation, every combination of source
+ * and destination bit phase, and region widths from one bit to 64 kilobits,
+ * timing `blit_rgn1_rop2()` for each. Prints a summary per operation and
+ * width, averaged over the phases, and optionally writes every measurement
+ * as comma-separated values for comparing one release with another. With
+ * \c --csv \c - the values go to standard output and the summary to standard
+ * error.
+ *
+ * Usage: blit_bench [--csv file] [--quick] [--isa n] [--min-time ms]
+ *
+ * \c --quick sweeps only phases 0, 3 and 6 and fewer widths. \c --isa selects
+ * the span kernels: 0 portable, 1 SSE2, 2 AVX2, 3 AVX-512. \c --min-time
+ * sets how long to repeat each measurement, in milliseconds.
+ */
+
+#include <blit/rop2.h>
+#include <blit/span.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/*!
+ * \brief Number of scanlines per blit.
+ */
+#define BENCH_HEIGHT 64
+
+/*!
+ * \brief Answers a monotonic time in nanoseconds.
+ */
+static double bench_now(void) {
+#ifdef _WIN32
+  LARGE_INTEGER count, frequency;
+  (void)QueryPerformanceCounter(&count);
+  (void)QueryPerformanceFrequency(&frequency);
+  return (double)count.QuadPart * 1e9 / (double)frequency.QuadPart;
+#else
+  struct timespec now;
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec * 1e9 + (double)now.tv_nsec;
+#endif
+}
+
+/*!
+ * \brief One measurement.
+ */
+struct bench_result {
+  double ns_per_call;
+  double mb_per_s;
+};
+
+/*!
+ * \brief Number of timed batches per measurement.
+ * \details The fastest batch counts. Slower batches met interruptions.
+ */
+#define BENCH_BATCHES 5
+
+/*!
+ * \brief Times one configuration.
+ * \details Doubles the repetitions until a batch takes at least the minimum
+ * time, then times further batches of that many and reports the fastest.
+ */
+static struct bench_result bench_run(struct blit_scan *result, const struct blit_scan *source, int x, int x_source, int width, enum blit_rop2 rop2,
+                                     double min_ns) {
+  int logic_count = 0;
+  long calls = 1;
+  double best = 0.0;
+  for (;; calls *= 2) {
+    const double start = bench_now();
+    for (long call = 0; call < calls; call++)
+      logic_count = blit_rop2(result, x, 0, width, BENCH_HEIGHT, source, x_source, 0, rop2);
+    best = bench_now() - start;
+    if (best >= min_ns || calls >= (1L << 30))
+      break;
+  }
+  for (int batch = 1; batch < BENCH_BATCHES; batch++) {
+    const double start = bench_now();
+    for (long call = 0; call < calls; call++)
+      (void)blit_rop2(result, x, 0, width, BENCH_HEIGHT, source, x_source, 0, rop2);
+    const double elapsed = bench_now() - start;
+    if (elapsed < best)
+      best = elapsed;
+  }
+  const struct bench_result bench = {
+      .ns_per_call = best / (double)calls,
+      .mb_per_s = (double)logic_count * (double)calls * 1e3 / best,
+  };
+  return bench;
+}
+
+int main(int argc, char *argv[]) {
+  static const int widths[] = {1, 7, 8, 31, 64, 100, 256, 1000, 4096, 16384, 65536};
+  static const int quick_widths[] = {1, 64, 1000, 65536};
+  const char *csv_path = NULL;
+  bool quick = false;
+  double min_ns = 1e6;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+      csv_path = argv[++i];
+    } else if (strcmp(argv[i], "--quick") == 0) {
+      quick = true;
+    } else if (strcmp(argv[i], "--isa") == 0 && i + 1 < argc) {
+      if (!blit_span_isa_select((enum blit_span_isa)atoi(argv[++i]))) {
+        (void)fprintf(stderr, "blit_bench: instruction set %s unsupported\n", argv[i]);
+        return EXIT_FAILURE;
+      }
+    } else if (strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+      min_ns = atof(argv[++i]) * 1e6;
+    } else {
+      (void)fprintf(stderr, "usage: %s [--csv file] [--quick] [--isa n] [--min-time ms]\n", argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  FILE *csv = NULL;
+  if (csv_path != NULL) {
+    csv = strcmp(csv_path, "-") == 0 ? stdout : fopen(csv_path, "w");
+    if (csv == NULL) {
+      perror(csv_path);
+      return EXIT_FAILURE;
+    }
+    (void)fprintf(csv, "isa,rop2,phase,phase_source,width,height,ns_per_call,mb_per_s\n");
+  }
+
+  /*
+   * Scans wide enough for the widest region at the largest phase, filled with
+   * noise so that no operation degenerates.
+   */
+  const int scan_width = 65536 + 8;
+  const int stride = (scan_width + 7) >> 3;
+  blit_scanline_t *result_store = malloc((size_t)stride * BENCH_HEIGHT);
+  blit_scanline_t *source_store = malloc((size_t)stride * BENCH_HEIGHT);
+  if (result_store == NULL || source_store == NULL) {
+    (void)fprintf(stderr, "blit_bench: out of memory\n");
+    return EXIT_FAILURE;
+  }
+  unsigned int seed = 1U;
+  for (int i = 0; i < stride * BENCH_HEIGHT; i++) {
+    seed = seed * 1103515245U + 12345U;
+    result_store[i] = (blit_scanline_t)(seed >> 16);
+    source_store[i] = (blit_scanline_t)(seed >> 24);
+  }
+  struct blit_scan result = {.store = result_store, .width = scan_width, .height = BENCH_HEIGHT, .stride = stride};
+  const struct blit_scan source = {.store = source_store, .width = scan_width, .height = BENCH_HEIGHT, .stride = stride};
+
+  const int *sweep = quick ? quick_widths : widths;
+  const int sweep_count = quick ? (int)(sizeof(quick_widths) / sizeof(quick_widths[0])) : (int)(sizeof(widths) / sizeof(widths[0]));
+  const int isa = (int)blit_span_isa_selected();
+  FILE *summary = csv == stdout ? stderr : stdout;
+  (void)fprintf(summary, "isa %d, %d scanlines per call, mean over phases\n", isa, BENCH_HEIGHT);
+  (void)fprintf(summary, "%5s %8s %14s %12s\n", "rop2", "width", "ns/call", "MB/s");
+  for (int rop2 = blit_rop2_0; rop2 <= blit_rop2_1; rop2++) {
+    for (int w = 0; w < sweep_count; w++) {
+      double ns_sum = 0.0, mb_sum = 0.0;
+      int runs = 0;
+      for (int phase = 0; phase < 8; phase += quick ? 3 : 1) {
+        for (int phase_source = 0; phase_source < 8; phase_source += quick ? 3 : 1) {
+          const struct bench_result bench = bench_run(&result, &source, phase, phase_source, sweep[w], (enum blit_rop2)rop2, min_ns);
+          if (csv != NULL)
+            (void)fprintf(csv, "%d,%d,%d,%d,%d,%d,%.3f,%.3f\n", isa, rop2, phase, phase_source, sweep[w], BENCH_HEIGHT, bench.ns_per_call, bench.mb_per_s);
+          ns_sum += bench.ns_per_call;
+          mb_sum += bench.mb_per_s;
+          runs++;
+        }
+      }
+      (void)fprintf(summary, "%5d %8d %14.1f %12.1f\n", rop2, sweep[w], ns_sum / runs, mb_sum / runs);
+    }
+  }
+
+  if (csv != NULL && csv != stdout)
+    (void)fclose(csv);
+  free(result_store);
+  free(source_store);
+  return EXIT_SUCCESS;
+}
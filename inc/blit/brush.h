@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/brush.h
+ * \brief Tiled pattern brushes.
+ * \details This header file defines the `blit_brush` structure and the
+ * function that expands a brush into destination-aligned scanline bytes. A
+ * brush tiles a pattern scan across the whole destination plane, anchored at
+ * a brush origin; raster operations with a pattern operand read it.
+ */
+
+#ifndef __BLIT_BRUSH_H__
+#define __BLIT_BRUSH_H__
+
+#include <blit/scan.h>
+
+/*!
+ * \brief Brush structure.
+ * \details The pattern repeats in both directions without end. Pattern pixel
+ * (0, 0) lands on destination pixel (\c x, \c y), and so on every pattern
+ * width and height from there, left and right, up and down. Patterns of any
+ * positive width and height work; 8-by-8 patterns are the usual case.
+ * Operations that read an empty pattern do nothing and answer 0.
+ */
+struct blit_brush {
+  /*!
+   * \brief Pointer to the pattern scan.
+   * \details The pattern must not share storage with the destination.
+   */
+  const struct blit_scan *pattern;
+  /*!
+   * \brief Destination x-coordinate of the pattern origin.
+   */
+  int x;
+  /*!
+   * \brief Destination y-coordinate of the pattern origin.
+   */
+  int y;
+};
+
+/*!
+ * \brief Expands a brush into scanline bytes.
+ * \details Stores the brush bits for destination pixels \c x through
+ * `x + 8 * count - 1` of destination row \c y, most-significant bit first,
+ * as if the tiled pattern were itself a scan aligned with the destination.
+ *
+ * A pattern row tiles with a period of `width / gcd(width, 8)` bytes, one byte
+ * for patterns 8 pixels wide. The function works out one period, funnel
+ * shifting whole pattern bytes when the width is a multiple of 8 and
+ * gathering bits otherwise, then doubles it across the rest of the bytes.
+ * \param brush Pointer to the brush.
+ * \param x Destination x-coordinate of the first bit.
+ * \param y Destination y-coordinate of the row.
+ * \param store Receives \c count bytes.
+ * \param count Number of bytes to store.
+ */
+void blit_brush_expand(const struct blit_brush *brush, int x, int y, blit_scanline_t *store, int count);
+
+#endif /* __BLIT_BRUSH_H__ */
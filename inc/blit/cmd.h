@@ -0,0 +1,166 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/cmd.h
+ * \brief Batched blit command lists.
+ * \details This header file declares command lists: record many binary
+ * raster operations, then run them together. Recording clips each command
+ * once and works out its logic count there and then. Running drops commands
+ * that a later opaque command covers completely, merges adjacent commands
+ * that continue one another, and works through the destination in bands of
+ * rows so that each band stays in cache while every command touching it
+ * runs.
+ *
+ * The result is always the same as running the commands one by one in
+ * record order. When any command reads from a scan that a command writes,
+ * the list runs in plain record order without dropping, merging or banding.
+ */
+
+#ifndef __BLIT_CMD_H__
+#define __BLIT_CMD_H__
+
+#include <blit/rop2.h>
+
+/*!
+ * \brief Blit command structure.
+ * \details One recorded binary raster operation, its regions already
+ * normalised, moved and clipped.
+ */
+struct blit_cmd {
+  /*!
+   * \brief Pointer to the destination scan structure.
+   */
+  struct blit_scan *result;
+  /*!
+   * \brief Pointer to the source scan structure.
+   */
+  const struct blit_scan *source;
+  /*!
+   * \brief Clipped x-axis region.
+   */
+  struct blit_rgn1 x;
+  /*!
+   * \brief Clipped y-axis region.
+   */
+  struct blit_rgn1 y;
+  /*!
+   * \brief The raster operation code.
+   */
+  enum blit_rop2 rop2;
+  /*!
+   * \brief Logic count.
+   * \details The count that `blit_rgn1_rop2()` answers for the command on its
+   * own, whether or not running the list drops or merges it.
+   */
+  int logic_count;
+  /*!
+   * \brief Command still runs.
+   * \details Running clears this for commands that it drops or merges into
+   * an earlier command; the earlier command's regions then grow to cover
+   * both.
+   */
+  bool live;
+};
+
+/*!
+ * \brief Blit command list structure.
+ * \details The caller provides the command storage.
+ */
+struct blit_cmd_list {
+  /*!
+   * \brief Pointer to the command storage.
+   */
+  struct blit_cmd *cmds;
+  /*!
+   * \brief Number of recorded commands.
+   */
+  int count;
+  /*!
+   * \brief Maximum number of commands.
+   */
+  int capacity;
+};
+
+/*!
+ * \brief Macro to define a command list with storage.
+ * \param name The name of the command list structure.
+ * \param capacity The maximum number of commands.
+ */
+#define BLIT_CMD_LIST_DEFINE(name, capacity) \
+  struct blit_cmd name##_cmds[capacity];     \
+  struct blit_cmd_list name = {name##_cmds, 0, (capacity)}
+
+/*!
+ * \brief Records a binary raster operation.
+ * \details Takes the same arguments as `blit_rop2()` but runs nothing yet.
+ * The scans must stay valid until the list runs.
+ * \param list Pointer to the command list.
+ * \param result Pointer to the destination scan structure.
+ * \param x The x-coordinate of the origin of the region.
+ * \param y The y-coordinate of the origin of the region.
+ * \param x_extent The extent of the region in the x-axis.
+ * \param y_extent The extent of the region in the y-axis.
+ * \param source Pointer to the source scan structure.
+ * \param x_source The x-coordinate of the origin of the source region.
+ * \param y_source The y-coordinate of the origin of the source region.
+ * \param rop2 The raster operation code.
+ * \return Index of the recorded command, or -1 if the list is full.
+ */
+int blit_cmd_rop2(struct blit_cmd_list *list, struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent,
+                  const struct blit_scan *source, const int x_source, const int y_source, enum blit_rop2 rop2);
+
+/*!
+ * \brief Runs the recorded commands.
+ * \details Leaves the commands recorded, with their logic counts, for the
+ * caller to inspect. Clear the list before recording the next batch; running
+ * the same list twice would run only what the first run left live.
+ * \param list Pointer to the command list.
+ * \return The sum of the commands' logic counts.
+ */
+int blit_cmd_list_run(struct blit_cmd_list *list);
+
+/*!
+ * \brief Type definition for a band consumer.
+ * \details Receives each finished band in turn, top to bottom, for streaming
+ * out. The band's pixels are valid only until the consumer returns.
+ * \param context The consumer's context.
+ * \param band Pointer to the band's scan, as wide as the page and as tall
+ * as the band; the last band may be shorter.
+ * \param y Page row of the band's first scanline.
+ * \retval true to continue with the next band.
+ * \retval false to stop.
+ */
+typedef bool (*blit_cmd_band_func_t)(void *context, const struct blit_scan *band, int y);
+
+/*!
+ * \brief Runs the recorded commands a band at a time.
+ * \details Renders a page too large to hold in memory. Record the commands
+ * against a virtual page, a scan with dimensions but no store, for example
+ * `BLIT_SCAN_INIT(NULL, width, height, 0)`. Every command must write to the
+ * page, and none may read from it. Running then clears the band buffer, replays
+ * into it every command that meets the band's rows, clipped to them, and
+ * hands the band to the consumer; then the next band.
+ *
+ * Covered commands drop and adjacent commands merge first, as for
+ * `blit_cmd_list_run()`; the same caveat about running a list twice applies.
+ * \param list Pointer to the command list.
+ * \param page Pointer to the virtual page scan structure.
+ * \param band Pointer to the band buffer's scan structure: at least as wide
+ * as the page, with its height setting the rows per band.
+ * \param func The band consumer.
+ * \param context The consumer's context.
+ * \return The sum of the commands' logic counts, or 0 without running
+ * anything if the band is too narrow or short, or if any command writes
+ * elsewhere or reads the page.
+ */
+int blit_cmd_list_band(struct blit_cmd_list *list, const struct blit_scan *page, struct blit_scan *band, blit_cmd_band_func_t func, void *context);
+
+/*!
+ * \brief Empties the command list.
+ * \param list Pointer to the command list.
+ */
+static inline void blit_cmd_list_clear(struct blit_cmd_list *list) { list->count = 0; }
+
+#endif /* __BLIT_CMD_H__ */
@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/count.h
+ * \brief Set-pixel statistics over regions.
+ * \details This header file declares read-only queries of a scan region:
+ * how many pixels are set, where each scanline's first and last set pixels
+ * lie, and the bounding box of all of them. Coverage checks, hit tests and
+ * ink estimates need no scratch blits; the queries write nothing but their
+ * answers.
+ */
+
+#ifndef __BLIT_COUNT_H__
+#define __BLIT_COUNT_H__
+
+#include <blit/rgn1.h>
+#include <blit/scan.h>
+
+#include <stdint.h>
+
+/*!
+ * \brief Region statistics structure.
+ */
+struct blit_count {
+  /*!
+   * \brief Number of set pixels.
+   */
+  uint64_t count;
+  /*!
+   * \brief Left of the set pixels' bounding box.
+   */
+  int x;
+  /*!
+   * \brief Top of the set pixels' bounding box.
+   */
+  int y;
+  /*!
+   * \brief Width of the bounding box, zero if no pixel is set.
+   */
+  int x_extent;
+  /*!
+   * \brief Height of the bounding box, zero if no pixel is set.
+   */
+  int y_extent;
+};
+
+/*!
+ * \brief Gathers statistics over a region of a scan.
+ * \details Normalises, moves and clips the regions as `blit_rgn1_rop1()`
+ * does, so there is no source; each region's source origin becomes its
+ * origin. Counting runs a machine word at a time, through the processor's
+ * population-count instruction where it has one and the span kernels use
+ * vectors, or else a portable bit-slicing count. First and last set pixels
+ * come from the first and last non-zero words, so rows cost little more than
+ * the count. Nothing but the answers is written.
+ * \param scan Pointer to the scan structure.
+ * \param x Pointer to the one-dimensional region structure for the x-axis.
+ * \param y Pointer to the one-dimensional region structure for the y-axis.
+ * \param count Pointer to the statistics, or \c NULL for none.
+ * \param first Receives, for each clipped scanline from the top, the
+ * x-coordinate of its first set pixel, or -1 if none; \c NULL for none.
+ * \param last Receives, likewise, the x-coordinate of each clipped
+ * scanline's last set pixel, or -1; \c NULL for none.
+ * \return The number of set pixels.
+ */
+uint64_t blit_rgn1_count(const struct blit_scan *scan, struct blit_rgn1 *x, struct blit_rgn1 *y, struct blit_count *count, int *first, int *last);
+
+/*!
+ * \brief Convenience function for gathering statistics over a region.
+ * \details For each scanline's first and last set pixels, call
+ * `blit_rgn1_count()`, whose regions report the clipped scanlines.
+ * \param scan Pointer to the scan structure.
+ * \param x The x-coordinate of the origin of the region.
+ * \param y The y-coordinate of the origin of the region.
+ * \param x_extent The extent of the region in the x-axis.
+ * \param y_extent The extent of the region in the y-axis.
+ * \param count Pointer to the statistics, or \c NULL for none.
+ * \return The number of set pixels.
+ */
+uint64_t blit_count(const struct blit_scan *scan, const int x, const int y, const int x_extent, const int y_extent, struct blit_count *count);
+
+#endif /* __BLIT_COUNT_H__ */
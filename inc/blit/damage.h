@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/damage.h
+ * \brief Damage tracking.
+ * \details This header file defines the damage accumulator. Attach one to a
+ * scan and every raster operation that writes the scan adds its clipped
+ * rectangle. A display driver then flushes only the damaged rectangles, or
+ * the scanlines they span, and clears the accumulator.
+ *
+ * The accumulator holds at most `BLIT_DAMAGE_RECT_MAX` rectangles. Adding a
+ * rectangle first merges it with any it covers, any that covers it, and any
+ * that it extends along a shared edge. When the rectangles still overflow,
+ * they collapse to their bounding box.
+ */
+
+#ifndef __BLIT_DAMAGE_H__
+#define __BLIT_DAMAGE_H__
+
+#include <blit/rgn1.h>
+#include <blit/scan.h>
+
+#include <stddef.h>
+
+#ifndef BLIT_DAMAGE_RECT_MAX
+/*!
+ * \brief Maximum number of damaged rectangles before collapsing to a bounding
+ * box.
+ */
+#define BLIT_DAMAGE_RECT_MAX 16
+#endif
+
+/*!
+ * \brief Damaged rectangle structure.
+ */
+struct blit_damage_rect {
+  int x;
+  int y;
+  int x_extent;
+  int y_extent;
+};
+
+/*!
+ * \brief Damage accumulator structure.
+ * \details Zero-initialise, or clear, before use.
+ */
+struct blit_damage {
+  /*!
+   * \brief Damaged rectangles. They may overlap, but none covers another.
+   */
+  struct blit_damage_rect rects[BLIT_DAMAGE_RECT_MAX];
+  /*!
+   * \brief Number of damaged rectangles.
+   */
+  int count;
+};
+
+/*!
+ * \brief Clears the damage accumulator.
+ * \param damage Pointer to the damage accumulator.
+ */
+static inline void blit_damage_clear(struct blit_damage *damage) { damage->count = 0; }
+
+/*!
+ * \brief Adds a damaged rectangle.
+ * \details Ignores empty rectangles.
+ * \param damage Pointer to the damage accumulator.
+ * \param x The x-coordinate of the origin of the rectangle.
+ * \param y The y-coordinate of the origin of the rectangle.
+ * \param x_extent The extent of the rectangle in the x-axis.
+ * \param y_extent The extent of the rectangle in the y-axis.
+ */
+void blit_damage_add(struct blit_damage *damage, int x, int y, int x_extent, int y_extent);
+
+/*!
+ * \brief Answers the bounding box of the damage.
+ * \param damage Pointer to the damage accumulator.
+ * \param bounds Receives the bounding box.
+ * \retval true if there is damage.
+ * \retval false if there is none, in which case \c bounds does not change.
+ */
+bool blit_damage_bounds(const struct blit_damage *damage, struct blit_damage_rect *bounds);
+
+/*!
+ * \brief Adds clipped regions to a scan's damage accumulator, if any.
+ * \details Raster operations call this with their clipped destination
+ * regions after deciding that they will write.
+ * \param scan Pointer to the destination scan structure.
+ * \param x Pointer to the clipped x-axis region.
+ * \param y Pointer to the clipped y-axis region.
+ */
+static inline void blit_scan_damage(const struct blit_scan *scan, const struct blit_rgn1 *x, const struct blit_rgn1 *y) {
+  if (scan->damage != NULL)
+    blit_damage_add(scan->damage, x->origin, y->origin, x->extent, y->extent);
+}
+
+#endif /* __BLIT_DAMAGE_H__ */
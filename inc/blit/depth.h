@@ -0,0 +1,138 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/depth.h
+ * \brief Packed multi-bit pixels.
+ * \details This header file declares support for scans of packed 2-, 4- and
+ * 8-bit pixels, as grey-level e-paper and LCD controllers take them: four,
+ * two or one pixels per byte, the leftmost pixel in the most-significant bits.
+ *
+ * A row of \e w packed pixels of depth \e d is a row of `w * d` bits, and a
+ * bitwise raster operation on packed pixels is the same operation on their
+ * bits. A packed scan is therefore an ordinary scan whose width counts bits,
+ * and the functions here scale pixel coordinates to bit coordinates before
+ * handing them to the one-bit operations. Pixels never straddle bytes, so
+ * the edge masks fall on pixel boundaries and the word-wide span kernels run
+ * unchanged.
+ */
+
+#ifndef __BLIT_DEPTH_H__
+#define __BLIT_DEPTH_H__
+
+#include <blit/rop2.h>
+
+/*!
+ * \brief Macro to define a scan of packed pixels with storage.
+ * \param name The name of the scanline structure.
+ * \param width The width of the scan in pixels.
+ * \param height The height of the scan in pixels.
+ * \param depth Bits per pixel: 1, 2, 4 or 8.
+ */
+#define BLIT_SCAN_DEFINE_DEPTH(name, width, height, depth) BLIT_SCAN_DEFINE(name, (width) * (depth), height)
+
+/*!
+ * \brief Macro to define a static scan of packed pixels with storage.
+ * \param name The name of the static scanline structure.
+ * \param width The width of the scan in pixels.
+ * \param height The height of the scan in pixels.
+ * \param depth Bits per pixel: 1, 2, 4 or 8.
+ */
+#define BLIT_SCAN_DEFINE_DEPTH_STATIC(name, width, height, depth) BLIT_SCAN_DEFINE_STATIC(name, (width) * (depth), height)
+
+/*!
+ * \brief Scales a one-dimensional region from pixels to bits.
+ * \param rgn1 Pointer to the region structure, in pixels.
+ * \param depth Bits per pixel.
+ */
+static inline void blit_rgn1_depth(struct blit_rgn1 *rgn1, int depth) {
+  rgn1->origin *= depth;
+  rgn1->extent *= depth;
+  rgn1->origin_source *= depth;
+}
+
+/*!
+ * \brief Answers a packed pixel.
+ * \param scan Pointer to the scan structure.
+ * \param x The x-coordinate of the pixel.
+ * \param y The y-coordinate of the pixel.
+ * \param depth Bits per pixel: 1, 2, 4 or 8.
+ * \return The pixel value.
+ */
+static inline unsigned int blit_depth_pixel(const struct blit_scan *scan, int x, int y, int depth) {
+  const int bit = x * depth;
+  return (*blit_scan_find(scan, bit, y) >> (8 - depth - (bit & 7))) & ((1U << depth) - 1U);
+}
+
+/*!
+ * \brief Stores a packed pixel.
+ * \param scan Pointer to the scan structure.
+ * \param x The x-coordinate of the pixel.
+ * \param y The y-coordinate of the pixel.
+ * \param depth Bits per pixel: 1, 2, 4 or 8.
+ * \param pixel The pixel value.
+ */
+static inline void blit_depth_set_pixel(struct blit_scan *scan, int x, int y, int depth, unsigned int pixel) {
+  const int bit = x * depth;
+  const int shift = 8 - depth - (bit & 7);
+  const unsigned int mask = ((1U << depth) - 1U) << shift;
+  blit_scanline_t *store = blit_scan_find(scan, bit, y);
+  *store = (blit_scanline_t)((*store & ~mask) | ((pixel << shift) & mask));
+}
+
+/*!
+ * \brief Perform binary raster operation on packed pixels.
+ * \details Scales the regions to bits, then runs `blit_rgn1_rop2()`. Its
+ * clipping, overlap handling and kernels apply unchanged. On return, the
+ * regions hold the clipped regions in pixels.
+ * \param result Pointer to the destination scan structure.
+ * \param x Pointer to the one-dimensional region structure for the x-axis,
+ * in pixels.
+ * \param y Pointer to the one-dimensional region structure for the y-axis.
+ * \param source Pointer to the source scan structure, of the same depth.
+ * \param depth Bits per pixel: 1, 2, 4 or 8.
+ * \param rop2 The raster operation code, applied to every bit of every pixel.
+ * \return The number of logic operations performed, or 0 without touching
+ * the scan or the regions if the depth is not 1, 2, 4 or 8.
+ */
+int blit_rgn1_rop2_depth(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, int depth, enum blit_rop2 rop2);
+
+/*!
+ * \brief Convenience function for performing binary raster operations on
+ * packed pixels.
+ * \param result Pointer to the destination scan structure.
+ * \param x The x-coordinate of the origin of the region, in pixels.
+ * \param y The y-coordinate of the origin of the region.
+ * \param x_extent The extent of the region in the x-axis, in pixels.
+ * \param y_extent The extent of the region in the y-axis.
+ * \param source Pointer to the source scan structure, of the same depth.
+ * \param x_source The x-coordinate of the origin of the source region.
+ * \param y_source The y-coordinate of the origin of the source region.
+ * \param depth Bits per pixel: 1, 2, 4 or 8.
+ * \param rop2 The raster operation code.
+ * \return The number of logic operations performed, or 0 if the depth is not
+ * 1, 2, 4 or 8.
+ */
+int blit_rop2_depth(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source,
+                    const int x_source, const int y_source, int depth, enum blit_rop2 rop2);
+
+/*!
+ * \brief Combines a rectangle of packed pixels with one pixel value.
+ * \details Replicates the pixel across a byte and tiles it through
+ * `blit_tile()`, so a grey-level fill runs at the speed of a one-bit fill.
+ * \param result Pointer to the destination scan structure.
+ * \param x The x-coordinate of the origin of the region, in pixels.
+ * \param y The y-coordinate of the origin of the region.
+ * \param x_extent The extent of the region in the x-axis, in pixels.
+ * \param y_extent The extent of the region in the y-axis.
+ * \param depth Bits per pixel: 1, 2, 4 or 8.
+ * \param pixel The pixel value, standing in for the source.
+ * \param rop2 The raster operation code; `blit_rop2_S` fills.
+ * \return The number of logic operations performed, or 0 if the depth is not
+ * 1, 2, 4 or 8.
+ */
+int blit_fill_depth(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, int depth, unsigned int pixel,
+                    enum blit_rop2 rop2);
+
+#endif /* __BLIT_DEPTH_H__ */
@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/expand.h
+ * \brief Colour expansion to chunky pixels.
+ * \details This header file declares the `blit_chunky` structure, a buffer of
+ * 8-, 16- or 32-bit pixels such as a compositor takes, and the functions that
+ * expand one-bit scans into it: foreground colour where a bit is 1,
+ * background colour where it is 0, or the pixel left alone where it is 0 and
+ * the background is transparent.
+ */
+
+#ifndef __BLIT_EXPAND_H__
+#define __BLIT_EXPAND_H__
+
+#include <blit/rgn1.h>
+#include <blit/scan.h>
+
+/*!
+ * \brief Chunky pixel buffer structure.
+ * \details Pixels are native-endian integers of \c depth bits: indexed or
+ * grey 8-bit pixels, RGB565 16-bit pixels or ARGB8888 32-bit pixels, say. The
+ * library only copies them.
+ */
+struct blit_chunky {
+  /*!
+   * \brief Pointer to the first pixel of the first row.
+   */
+  void *store;
+  /*!
+   * \brief Width in pixels.
+   */
+  int width;
+  /*!
+   * \brief Height in pixels.
+   */
+  int height;
+  /*!
+   * \brief Number of bytes between the start of each row.
+   */
+  int stride;
+  /*!
+   * \brief Bits per pixel: 8, 16 or 32.
+   * \details Expansion refuses any other depth.
+   */
+  int depth;
+};
+
+/*!
+ * \brief Expand a region of a scan into chunky pixels.
+ * \details Clips the regions against the chunky destination and the source
+ * scan as `blit_rgn1_rop2()` does, with the chunky buffer standing in for the
+ * destination. Source bits phase-align to whole bytes, then each source byte
+ * expands through a table of pixel masks into 8 pixels, 64 bits at a time:
+ * one table look-up per 8, 4 or 2 pixels for 8-, 16- and 32-bit pixels.
+ * \param result Pointer to the chunky destination.
+ * \param x Pointer to the one-dimensional region structure for the x-axis.
+ * \param y Pointer to the one-dimensional region structure for the y-axis.
+ * \param source Pointer to the source scan structure.
+ * \param foreground Pixel for source bits of 1.
+ * \param background Pixel for source bits of 0.
+ * \param transparent True to leave the destination pixel alone for source
+ * bits of 0, ignoring the background.
+ * \return The number of pixels expanded, or 0 without expanding anything if
+ * the destination depth is not 8, 16 or 32.
+ */
+int blit_rgn1_expand(struct blit_chunky *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, uint32_t foreground,
+                     uint32_t background, bool transparent);
+
+/*!
+ * \brief Convenience function for expanding a region of a scan into chunky
+ * pixels.
+ * \param result Pointer to the chunky destination.
+ * \param x The x-coordinate of the origin of the region.
+ * \param y The y-coordinate of the origin of the region.
+ * \param x_extent The extent of the region in the x-axis.
+ * \param y_extent The extent of the region in the y-axis.
+ * \param source Pointer to the source scan structure.
+ * \param x_source The x-coordinate of the origin of the source region.
+ * \param y_source The y-coordinate of the origin of the source region.
+ * \param foreground Pixel for source bits of 1.
+ * \param background Pixel for source bits of 0.
+ * \param transparent True to leave the destination pixel alone for source
+ * bits of 0.
+ * \return The number of pixels expanded, or 0 if the destination depth is
+ * not 8, 16 or 32.
+ */
+int blit_expand(struct blit_chunky *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source,
+                const int x_source, const int y_source, uint32_t foreground, uint32_t background, bool transparent);
+
+#endif /* __BLIT_EXPAND_H__ */
@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/mirror.h
+ * \brief Horizontally mirrored blits.
+ * \details This header file declares the binary raster operations that read
+ * their source right to left, mirroring it left for right, for flipped
+ * sprites and for rear-projection and head-up displays. There is no need to
+ * keep mirrored copies of sprites.
+ */
+
+#ifndef __BLIT_MIRROR_H__
+#define __BLIT_MIRROR_H__
+
+#include <blit/rop2.h>
+
+/*!
+ * \brief Number of bytes staged per band of mirrored scanlines.
+ * \details Scanlines wider than this, less two bytes, go in column chunks.
+ */
+#ifndef BLIT_MIRROR_STAGE
+#define BLIT_MIRROR_STAGE 8192
+#endif
+
+/*!
+ * \brief Perform mirrored raster operation on regions of scans.
+ * \details Destination pixel `x->origin + i` takes source pixel
+ * `x->origin_source + x->extent - 1 - i`. Clipping follows
+ * `blit_rgn1_rop2()`, with the x-axis mirrored: clipping the destination's
+ * left edge shortens the source range at its right, and so on. On return,
+ * the x-axis region's source origin is the leftmost source pixel used.
+ *
+ * Each band of scanlines reverses into a stage a machine word at a time: one
+ * load, a lane-wise bit reversal, a byte swap and one store for every word of
+ * source. The reversed source is an ordinary source at some bit phase, so
+ * the band then runs through the usual phase-aligned loops and span kernels.
+ * Destination and source may share storage, as for `blit_rgn1_rop2()`.
+ * Scanlines wider than the stage that mirror onto themselves go in pairs of
+ * chunks, from both ends towards the middle, each pair staged before either
+ * transfers.
+ * \param result Pointer to the destination scan structure.
+ * \param x Pointer to the one-dimensional region structure for the x-axis.
+ * \param y Pointer to the one-dimensional region structure for the y-axis.
+ * \param source Pointer to the source scan structure.
+ * \param rop2 The raster operation code.
+ * \return The number of logic operations performed.
+ */
+int blit_rgn1_rop2_mirror(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, enum blit_rop2 rop2);
+
+/*!
+ * \brief Convenience function for performing mirrored raster operations.
+ * \param result Pointer to the destination scan structure.
+ * \param x The x-coordinate of the origin of the region in the destination.
+ * \param y The y-coordinate of the origin of the region in the destination.
+ * \param x_extent The extent of the region in the x-axis.
+ * \param y_extent The extent of the region in the y-axis.
+ * \param source Pointer to the source scan structure.
+ * \param x_source The x-coordinate of the origin of the region in the source.
+ * \param y_source The y-coordinate of the origin of the region in the source.
+ * \param rop2 The raster operation code.
+ * \return The number of logic operations performed.
+ */
+int blit_rop2_mirror(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source,
+                     const int x_source, const int y_source, enum blit_rop2 rop2);
+
+#endif /* __BLIT_MIRROR_H__ */
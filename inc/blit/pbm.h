@@ -0,0 +1,95 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/pbm.h
+ * \brief Binary portable bitmap files.
+ * \details This header file declares loading and storing of binary portable
+ * bitmaps, format P4. Their rows are most-significant bit first and padded
+ * to whole bytes, exactly as scanlines are, so a scan can point straight at
+ * a file's pixels: in memory, or mapped from the file system with no copy.
+ * A set bit is black in the file and a set pixel in the scan.
+ */
+
+#ifndef __BLIT_PBM_H__
+#define __BLIT_PBM_H__
+
+#include <blit/scan.h>
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/*!
+ * \brief Mapped bitmap file structure.
+ */
+struct blit_pbm_map {
+  /*!
+   * \brief Scan whose store points into the mapping.
+   */
+  struct blit_scan scan;
+  /*!
+   * \brief Address of the mapping, or \c NULL if none.
+   */
+  void *address;
+  /*!
+   * \brief Size of the mapping in bytes.
+   */
+  size_t size;
+};
+
+/*!
+ * \brief Points a scan at the pixels of a bitmap in memory.
+ * \details Parses the header: the magic number, width and height, separated
+ * by white space and comments, then one white-space character. Copies
+ * nothing; the scan's store points into the data, which must outlive it.
+ * Only the first image counts.
+ * \param scan Pointer to the scan structure to initialise. Damage tracking
+ * is off.
+ * \param data The file's bytes.
+ * \param size Number of bytes.
+ * \retval true if the data holds a whole P4 bitmap.
+ * \retval false if not, in which case \c scan does not change.
+ */
+bool blit_pbm_parse(struct blit_scan *scan, const void *data, size_t size);
+
+/*!
+ * \brief Maps a bitmap file.
+ * \details Maps the whole file, read-only or copy-on-write, then parses it
+ * in place. Writing to a read-only mapping's scan faults. Writing to a
+ * copy-on-write mapping's scan changes private copies of the pages it
+ * touches, never the file.
+ * \param map Pointer to the map structure to initialise.
+ * \param path Path to the file.
+ * \param writable \c true for copy-on-write, \c false for read-only.
+ * \retval true if mapped.
+ * \retval false if the file does not open, map or parse, in which case
+ * nothing stays mapped.
+ */
+bool blit_pbm_map(struct blit_pbm_map *map, const char *path, bool writable);
+
+/*!
+ * \brief Unmaps a bitmap file.
+ * \details Does nothing if nothing is mapped.
+ * \param map Pointer to the map structure.
+ */
+void blit_pbm_unmap(struct blit_pbm_map *map);
+
+/*!
+ * \brief Writes a region of a scan as a bitmap.
+ * \details Clips the region to the scan, then streams the header and rows.
+ * Byte-aligned rows go straight from the scan; others shift through a small
+ * fixed chunk. There is no intermediate image.
+ * \param file The stream, open for binary writing.
+ * \param scan Pointer to the scan structure.
+ * \param x The x-coordinate of the origin of the region.
+ * \param y The y-coordinate of the origin of the region.
+ * \param x_extent The extent of the region in the x-axis.
+ * \param y_extent The extent of the region in the y-axis.
+ * \retval true if every byte went to the stream.
+ * \retval false on a write error.
+ */
+bool blit_pbm_write(FILE *file, const struct blit_scan *scan, int x, int y, int x_extent, int y_extent);
+
+#endif /* __BLIT_PBM_H__ */
@@ -52,6 +52,19 @@ struct blit_phase_align {
   blit_scanline_t carry;
 };
 
+/*!
+ * \brief Phase alignment modes.
+ * \details The three ways of fetching source bytes: shifting left when the
+ * source bits sit further right within their bytes than the destination
+ * bits, not shifting when they sit at the same position, and shifting right
+ * when they sit further left.
+ */
+enum blit_phase_align_mode {
+  blit_phase_align_left_shift,
+  blit_phase_align_none,
+  blit_phase_align_right_shift,
+};
+
 /*!
  * \brief Initialises the phase alignment structure.
  * \details This function sets up the phase alignment structure with the given
@@ -79,6 +92,15 @@ void blit_phase_align_prefetch(struct blit_phase_align *align);
  */
 blit_scanline_t blit_phase_align_fetch(struct blit_phase_align *align);
 
+/*!
+ * \brief Answers the phase mode of the alignment structure.
+ * \details Callers with specialised loops for each mode use this to choose a
+ * loop once, up front, then fetch without going through the structure.
+ * \param align Pointer to the phase alignment structure.
+ * \return The phase alignment mode.
+ */
+enum blit_phase_align_mode blit_phase_align_mode(const struct blit_phase_align *align);
+
 /*!
  * \brief Fetches a byte from a stored buffer.
  * \param x_store The source bit position relative to the given start of the
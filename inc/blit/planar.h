@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/planar.h
+ * \brief Multi-plane scans.
+ * \details This header file defines the `blit_planar` structure, a stack of
+ * one-bit planes sharing width, height and stride, such as the four planes
+ * of a 4-bit grey-level panel, and declares the binary raster operations that
+ * transfer every plane in one call. One call clips once and works out the
+ * phase alignment once for all the planes.
+ */
+
+#ifndef __BLIT_PLANAR_H__
+#define __BLIT_PLANAR_H__
+
+#include <blit/rop2.h>
+
+/*!
+ * \brief Maximum number of planes.
+ */
+#define BLIT_PLANAR_MAX 8
+
+/*!
+ * \brief Multi-plane scan structure.
+ * \details Plane \e p starts `p * plane_stride` bytes after \c store. Planes
+ * one after another in one buffer have a plane stride of `stride * height`.
+ * Interleaved planes, one scanline of each plane in turn, have a plane stride
+ * of one scanline and a stride of one scanline per plane.
+ */
+struct blit_planar {
+  /*!
+   * \brief Pointer to the first plane's data buffer.
+   */
+  blit_scanline_t *store;
+  /*!
+   * \brief Width of every plane in pixels.
+   */
+  int width;
+  /*!
+   * \brief Height of every plane in pixels.
+   */
+  int height;
+  /*!
+   * \brief Number of bytes between the start of each row of a plane.
+   */
+  int stride;
+  /*!
+   * \brief Number of bytes between the start of each plane.
+   */
+  int plane_stride;
+  /*!
+   * \brief Number of planes, 1 through `BLIT_PLANAR_MAX`.
+   */
+  int plane_count;
+  /*!
+   * \brief Damage accumulator for all planes, or null.
+   */
+  struct blit_damage *damage;
+};
+
+/*!
+ * \brief Macro to define a multi-plane scan structure with storage.
+ * \details The planes lie one after another in one storage array.
+ * \param name The name of the multi-plane scan structure.
+ * \param width The width of the planes in pixels.
+ * \param height The height of the planes in pixels.
+ * \param plane_count The number of planes.
+ */
+#define BLIT_PLANAR_DEFINE(name, width, height, plane_count)                     \
+  blit_scanline_t name##_store[(((width) + 7) >> 3) * (height) * (plane_count)]; \
+  struct blit_planar name = {name##_store, (width), (height), ((width) + 7) >> 3, (((width) + 7) >> 3) * (height), (plane_count), NULL}
+
+/*!
+ * \brief Macro to define a static multi-plane scan structure with storage.
+ * \param name The name of the static multi-plane scan structure.
+ * \param width The width of the planes in pixels.
+ * \param height The height of the planes in pixels.
+ * \param plane_count The number of planes.
+ */
+#define BLIT_PLANAR_DEFINE_STATIC(name, width, height, plane_count)                     \
+  static blit_scanline_t name##_store[(((width) + 7) >> 3) * (height) * (plane_count)]; \
+  static struct blit_planar name = {name##_store, (width), (height), ((width) + 7) >> 3, (((width) + 7) >> 3) * (height), (plane_count), NULL}
+
+/*!
+ * \brief Answers one plane as a scan.
+ * \details The scan shares the plane's storage and the damage accumulator,
+ * so that any other raster operation can work on a single plane.
+ * \param planar Pointer to the multi-plane scan structure.
+ * \param plane The plane, from 0.
+ * \return Scan structure for the plane.
+ */
+static inline struct blit_scan blit_planar_plane(const struct blit_planar *planar, int plane) {
+  struct blit_scan scan = {planar->store + planar->plane_stride * plane, planar->width, planar->height, planar->stride, planar->damage};
+  return scan;
+}
+
+/*!
+ * \brief Perform binary raster operations on regions of every plane.
+ * \details Clips the regions once, against the destination and the source,
+ * as `blit_rgn1_rop2()` does. Sets up the phase alignment once, then runs
+ * each plane through the transfer loop for its own operation. Per-plane
+ * operations make colour-keyed effects one call: copy some planes, clear or
+ * invert others.
+ *
+ * The source has either as many planes as the destination, or one plane that
+ * every destination plane reads. A one-plane source must not share storage
+ * with the destination. Overlapping destination and source planes otherwise
+ * work as for `blit_rgn1_rop2()`.
+ * \param result Pointer to the destination multi-plane scan structure.
+ * \param x Pointer to the one-dimensional region structure for the x-axis.
+ * \param y Pointer to the one-dimensional region structure for the y-axis.
+ * \param source Pointer to the source multi-plane scan structure.
+ * \param rop2 Array of raster operation codes, one for each destination
+ * plane.
+ * \return The number of logic operations performed, summed across planes,
+ * or 0 without transferring anything if the destination has no planes or
+ * more than `BLIT_PLANAR_MAX`, or the source has neither as many planes nor
+ * one.
+ */
+int blit_rgn1_planar_rop2(struct blit_planar *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_planar *source, const enum blit_rop2 *rop2);
+
+/*!
+ * \brief Convenience function for performing binary raster operations on
+ * every plane.
+ * \param result Pointer to the destination multi-plane scan structure.
+ * \param x The x-coordinate of the origin of the region.
+ * \param y The y-coordinate of the origin of the region.
+ * \param x_extent The extent of the region in the x-axis.
+ * \param y_extent The extent of the region in the y-axis.
+ * \param source Pointer to the source multi-plane scan structure.
+ * \param x_source The x-coordinate of the origin of the source region.
+ * \param y_source The y-coordinate of the origin of the source region.
+ * \param rop2 Array of raster operation codes, one for each destination
+ * plane.
+ * \return The number of logic operations performed.
+ */
+int blit_planar_rop2(struct blit_planar *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_planar *source,
+                     const int x_source, const int y_source, const enum blit_rop2 *rop2);
+
+#endif /* __BLIT_PLANAR_H__ */
@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/pool.h
+ * \brief Worker pool for band-parallel blits.
+ * \details This header file declares a fixed pool of worker threads. Once
+ * started, `blit_rgn1_rop2()` splits large transfers into bands of scanlines
+ * and runs the bands on the pool. Transfers below a size threshold, and
+ * transfers whose destination and source share storage, stay on the calling
+ * thread.
+ *
+ * The pool is optional twice over: it does nothing until started, and builds
+ * without the `BLIT_THREADS` option have no threads at all, in which case
+ * starting fails and every transfer runs serially.
+ */
+
+#ifndef __BLIT_POOL_H__
+#define __BLIT_POOL_H__
+
+#include <stdbool.h>
+
+/*!
+ * \brief Default size threshold in logic operations.
+ * \details Transfers touching fewer destination bytes than this run serially;
+ * waking the workers would cost more than it saves.
+ */
+#define BLIT_POOL_THRESHOLD_DEFAULT 65536
+
+/*!
+ * \brief Type definition for a pool job function pointer.
+ * \param context The context passed to `blit_pool_run()`.
+ * \param index The job index, 0 through `count - 1`.
+ */
+typedef void (*blit_pool_job_t)(void *context, int index);
+
+/*!
+ * \brief Starts the worker pool.
+ * \details Not thread safe; start before blitting on other threads.
+ * \param thread_count Number of worker threads. The calling thread works too,
+ * so \c thread_count workers give `thread_count + 1` threads in all.
+ * \retval true if started.
+ * \retval false if already started, if the count is not positive, if the
+ * build has no threads, or if a thread failed to start.
+ */
+bool blit_pool_start(int thread_count);
+
+/*!
+ * \brief Stops the worker pool and joins its threads.
+ * \details Does nothing if the pool has not started.
+ */
+void blit_pool_stop(void);
+
+/*!
+ * \brief Answers the number of worker threads.
+ * \return Number of workers, or 0 if the pool has not started.
+ */
+int blit_pool_thread_count(void);
+
+/*!
+ * \brief Sets the size threshold.
+ * \param logic_count Smallest number of logic operations worth running on
+ * the pool.
+ */
+void blit_pool_set_threshold(int logic_count);
+
+/*!
+ * \brief Tests whether a transfer is worth running on the pool.
+ * \param logic_count Number of logic operations in the transfer.
+ * \retval true if the pool has started and the count meets the threshold.
+ * \retval false otherwise.
+ */
+bool blit_pool_worthwhile(int logic_count);
+
+/*!
+ * \brief Runs jobs on the pool and waits for them all.
+ * \details Workers and the calling thread take jobs in index order until
+ * none remain. Every job runs exactly once. If the pool has not started, or
+ * another thread is already running jobs on it, the calling thread runs all
+ * the jobs itself.
+ * \param job The job function.
+ * \param context Context passed to every job.
+ * \param count Number of jobs.
+ */
+void blit_pool_run(blit_pool_job_t job, void *context, int count);
+
+#endif /* __BLIT_POOL_H__ */
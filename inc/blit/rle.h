@@ -0,0 +1,114 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/rle.h
+ * \brief Span-list compressed scans.
+ * \details This header file declares a compressed one-bit image: for each
+ * scanline, the list of its spans of set pixels. Mostly-clear pages and
+ * backgrounds shrink to a few spans per scanline, and clear scanlines to
+ * nothing. Compressed images encode from and decode to scans, and blit
+ * directly as sources without decoding.
+ */
+
+#ifndef __BLIT_RLE_H__
+#define __BLIT_RLE_H__
+
+#include <blit/rop2.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \brief Span-list compressed image structure.
+ * \details The caller supplies the storage. Widths cannot exceed 65,535.
+ */
+struct blit_rle {
+  /*!
+   * \brief Spans of set pixels, as pairs of first and past-last pixel,
+   * scanline by scanline and left to right within each scanline.
+   */
+  uint16_t *span;
+  /*!
+   * \brief Index of each scanline's first span, plus one past the last
+   * scanline's last span; one more entry than the height.
+   */
+  uint32_t *row;
+  /*!
+   * \brief Maximum number of spans that \c span can hold.
+   */
+  size_t span_max;
+  /*!
+   * \brief Width in pixels.
+   */
+  int width;
+  /*!
+   * \brief Height in scanlines.
+   */
+  int height;
+};
+
+/*!
+ * \brief Encodes a scan.
+ * \details Skips runs of clear and of set bytes a machine word at a time.
+ * Writes no more than \c span_max spans, but counts them all, so that a
+ * first call with no span storage can size a second. Spans that do not all
+ * fit leave the compressed image empty, with no width and no height.
+ *
+ * Spans hold 16-bit pixel positions, so scans wider than `UINT16_MAX` pixels
+ * do not encode. They leave the compressed image empty, with no width and
+ * no height, and answer no spans.
+ * \param rle Pointer to the compressed image, with \c row storage for at
+ * least one more entry than the scan's height.
+ * \param scan Pointer to the scan to encode.
+ * \return The number of spans. The encoding is complete only if this does
+ * not exceed \c span_max.
+ */
+size_t blit_rle_encode(struct blit_rle *rle, const struct blit_scan *scan);
+
+/*!
+ * \brief Decodes into a scan.
+ * \details Clears each scanline, then sets its spans. The scan must be at
+ * least as large as the compressed image.
+ * \param rle Pointer to the compressed image.
+ * \param scan Pointer to the destination scan.
+ */
+void blit_rle_decode(const struct blit_rle *rle, struct blit_scan *scan);
+
+/*!
+ * \brief Perform raster operation on regions with a compressed source.
+ * \details Clips as `blit_rgn1_rop2()`. Over a span of set source pixels,
+ * the operation reduces to a unary operation on the destination, and so it
+ * does between spans. Each reduces to clearing, setting, inverting or
+ * nothing, applied straight to the destination with edge masks and whole
+ * interior bytes. Where the reduction is nothing, there is no work: under
+ * `blit_rop2_paint`, the clear pixels between spans cost nothing, and under
+ * `blit_rop2_and`, the set pixels cost nothing.
+ * \param result Pointer to the destination scan structure.
+ * \param x Pointer to the one-dimensional region structure for the x-axis.
+ * \param y Pointer to the one-dimensional region structure for the y-axis.
+ * \param source Pointer to the compressed source image.
+ * \param rop2 The raster operation code.
+ * \return The number of logic operations performed.
+ */
+int blit_rgn1_rop2_rle(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_rle *source, enum blit_rop2 rop2);
+
+/*!
+ * \brief Convenience function for performing raster operations with a
+ * compressed source.
+ * \param result Pointer to the destination scan structure.
+ * \param x The x-coordinate of the origin of the region in the destination.
+ * \param y The y-coordinate of the origin of the region in the destination.
+ * \param x_extent The extent of the region in the x-axis.
+ * \param y_extent The extent of the region in the y-axis.
+ * \param source Pointer to the compressed source image.
+ * \param x_source The x-coordinate of the origin of the region in the source.
+ * \param y_source The y-coordinate of the origin of the region in the source.
+ * \param rop2 The raster operation code.
+ * \return The number of logic operations performed.
+ */
+int blit_rop2_rle(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_rle *source,
+                  const int x_source, const int y_source, enum blit_rop2 rop2);
+
+#endif /* __BLIT_RLE_H__ */
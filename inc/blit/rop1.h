@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/rop1.h
+ * \brief Unary raster operations.
+ * \details This header file declares the enumeration of unary raster
+ * operation codes, and the functions that apply them to regions of a scan.
+ * Unary operations read and write the destination only: clear, set, invert or
+ * leave alone. They need no source scan and no phase alignment.
+ */
+
+#ifndef __BLIT_ROP1_H__
+#define __BLIT_ROP1_H__
+
+#include <blit/rgn1.h>
+#include <blit/scan.h>
+
+/*!
+ * \brief Enumeration of unary raster operation codes.
+ * \details Each code is the truth table of its operation: bit D of the code
+ * gives the result for destination bit D. The binary raster operation codes
+ * use the same scheme with source bit S selecting the upper or lower pair of
+ * bits, so a binary operation that ignores its source has the unary code in
+ * both pairs. For example, `blit_rop2_Dn` is `blit_rop1_Dn` repeated.
+ */
+enum blit_rop1 {
+  blit_rop1_0,
+  blit_rop1_Dn,
+  blit_rop1_D,
+  blit_rop1_1,
+  /*
+   * Common raster operation synonyms.
+   */
+  blit_rop1_blackness = blit_rop1_0,
+  blit_rop1_invert = blit_rop1_Dn,
+  blit_rop1_nop = blit_rop1_D,
+  blit_rop1_whiteness = blit_rop1_1,
+};
+
+/*!
+ * \brief Perform unary raster operation on a region of a scan.
+ * \details Normalises, moves and clips the regions against the destination
+ * only. There is no source, so the function first sets each region's source
+ * origin to its origin. Clearing and setting mask the first and last byte of
+ * each scanline and fill the bytes between with `memset()`. Inverting runs
+ * the vectorised span kernel across the middle. Leaving the destination alone
+ * touches nothing.
+ * \param result Pointer to the destination scan structure.
+ * \param x Pointer to the one-dimensional region structure for the x-axis.
+ * \param y Pointer to the one-dimensional region structure for the y-axis.
+ * \param rop1 The raster operation code.
+ * \return The number of logic operations performed, counted as for
+ * `blit_rgn1_rop2()`: every destination byte the clipped region covers, whole
+ * or partial. The count for `blit_rop1_D` is the same even though no byte
+ * changes, so that a non-zero count always means a non-empty region.
+ */
+int blit_rgn1_rop1(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, enum blit_rop1 rop1);
+
+/*!
+ * \brief Convenience function for performing unary raster operations.
+ * \param result Pointer to the destination scan structure.
+ * \param x The x-coordinate of the origin of the region.
+ * \param y The y-coordinate of the origin of the region.
+ * \param x_extent The extent of the region in the x-axis.
+ * \param y_extent The extent of the region in the y-axis.
+ * \param rop1 The raster operation code to apply.
+ * \return The number of logic operations performed.
+ */
+int blit_rop1(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, enum blit_rop1 rop1);
+
+#endif /* __BLIT_ROP1_H__ */
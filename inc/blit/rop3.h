@@ -0,0 +1,105 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/rop3.h
+ * \brief Ternary raster operations.
+ * \details This header file declares the ternary raster operation codes and
+ * the functions that apply them. Ternary operations combine destination,
+ * source and a tiled pattern brush, all 256 of them, in a single pass over
+ * the destination.
+ */
+
+#ifndef __BLIT_ROP3_H__
+#define __BLIT_ROP3_H__
+
+#include <blit/brush.h>
+#include <blit/rop2.h>
+
+/*!
+ * \brief Enumeration of ternary raster operation codes.
+ * \details Each code is the truth table of its operation: bit `4P + 2S + D`
+ * of the code gives the result for pattern bit P, source bit S and
+ * destination bit D. The lower four bits are therefore the binary operation
+ * applied where the pattern is 0, and the upper four where it is 1. The
+ * codes match the ternary raster operation codes of other graphics
+ * interfaces: pattern 0xf0, source 0xcc, destination 0xaa.
+ *
+ * Only common codes have names. Any code from 0 through 255 is valid.
+ */
+enum blit_rop3 {
+  blit_rop3_blackness = 0x00,
+  blit_rop3_not_src_erase = 0x11,
+  blit_rop3_not_src_copy = 0x33,
+  blit_rop3_src_erase = 0x44,
+  blit_rop3_dst_invert = 0x55,
+  blit_rop3_pat_invert = 0x5a,
+  blit_rop3_src_invert = 0x66,
+  blit_rop3_src_and = 0x88,
+  blit_rop3_merge_paint = 0xbb,
+  blit_rop3_merge_copy = 0xc0,
+  blit_rop3_src_copy = 0xcc,
+  blit_rop3_stencil = 0xe2,
+  blit_rop3_src_paint = 0xee,
+  blit_rop3_pat_copy = 0xf0,
+  blit_rop3_pat_paint = 0xfb,
+  blit_rop3_whiteness = 0xff,
+};
+
+/*!
+ * \brief Answers the ternary code for a binary raster operation.
+ * \details The binary operation applies whether the pattern is 0 or 1.
+ * \param rop2 The binary raster operation code.
+ * \return The equivalent ternary raster operation code.
+ */
+static inline enum blit_rop3 blit_rop3_rop2(enum blit_rop2 rop2) { return (enum blit_rop3)(rop2 * 0x11); }
+
+/*!
+ * \brief Perform ternary raster operation on regions of scans.
+ * \details Clips the regions against the destination and the source as
+ * `blit_rgn1_rop2()` does, and handles overlapping destination and source in
+ * the same way. The brush tiles the whole destination plane so needs no
+ * clipping.
+ *
+ * Each scanline runs once, in chunks small enough to stay in cache: the brush
+ * expands into one buffer and the phase-aligned source into another, then a
+ * word-wide multiplexer evaluates the code across destination, source and
+ * pattern at once. Codes that ignore the pattern go to `blit_rgn1_rop2()`.
+ * Codes that ignore the source neither clip against it nor fetch from it;
+ * the source may then be null, and the regions' source origins follow their
+ * origins.
+ * \param result Pointer to the destination scan structure.
+ * \param x Pointer to the one-dimensional region structure for the x-axis.
+ * \param y Pointer to the one-dimensional region structure for the y-axis.
+ * \param source Pointer to the source scan structure, or null if the code
+ * ignores the source.
+ * \param brush Pointer to the pattern brush, or null if the code ignores the
+ * pattern.
+ * \param rop3 The ternary raster operation code.
+ * \return The number of logic operations performed, counted as for
+ * `blit_rgn1_rop2()`, or 0 without touching the scan if the code reads an
+ * empty pattern.
+ */
+int blit_rgn1_rop3(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, const struct blit_brush *brush,
+                   enum blit_rop3 rop3);
+
+/*!
+ * \brief Convenience function for performing ternary raster operations.
+ * \param result Pointer to the destination scan structure.
+ * \param x The x-coordinate of the origin of the region.
+ * \param y The y-coordinate of the origin of the region.
+ * \param x_extent The extent of the region in the x-axis.
+ * \param y_extent The extent of the region in the y-axis.
+ * \param source Pointer to the source scan structure, or null.
+ * \param x_source The x-coordinate of the origin of the source region.
+ * \param y_source The y-coordinate of the origin of the source region.
+ * \param brush Pointer to the pattern brush, or null.
+ * \param rop3 The ternary raster operation code.
+ * \return The number of logic operations performed, or 0 if the code reads
+ * an empty pattern.
+ */
+int blit_rop3(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source, const int x_source,
+              const int y_source, const struct blit_brush *brush, enum blit_rop3 rop3);
+
+#endif /* __BLIT_ROP3_H__ */
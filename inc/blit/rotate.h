@@ -0,0 +1,92 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/rotate.h
+ * \brief Rotating and transposing blits.
+ * \details This header file declares the blit that rotates a rectangle of a
+ * scan by quarter turns, or transposes it, into another scan, for panels
+ * mounted in portrait. The rotated rectangle combines with the destination
+ * through any binary raster operation.
+ */
+
+#ifndef __BLIT_ROTATE_H__
+#define __BLIT_ROTATE_H__
+
+#include <blit/rop2.h>
+
+/*!
+ * \brief Enumeration of rotations.
+ * \details Turns are clockwise, with y increasing down the scan.
+ */
+enum blit_rotate {
+  /*!
+   * \brief No rotation.
+   */
+  blit_rotate_0,
+  /*!
+   * \brief Quarter turn: the source's bottom row becomes the left column.
+   */
+  blit_rotate_90,
+  /*!
+   * \brief Half turn.
+   */
+  blit_rotate_180,
+  /*!
+   * \brief Three-quarter turn: the source's top row becomes the left column,
+   * read from the bottom.
+   */
+  blit_rotate_270,
+  /*!
+   * \brief Transpose: the source's rows become columns, left to right.
+   */
+  blit_rotate_transpose,
+};
+
+/*!
+ * \brief Rotates a rectangle of a scan into regions of another scan.
+ * \details The regions give the rotated rectangle in the destination and the
+ * top-left corner of the source rectangle. Their extents count destination
+ * pixels, so quarter turns and transposing read a source rectangle with the
+ * extents swapped. Clipping keeps only the source pixels that lie inside the
+ * source and land inside the destination. On return, the regions hold the
+ * clipped destination region, with source origins at the top-left corner of
+ * the source rectangle that remains.
+ *
+ * The destination runs in bands of 8 scanlines. Each 8×8 block of a band
+ * gathers 8 source bytes, transposes them as one 64-bit bit matrix and
+ * reverses bits or rows for the turn. Each band then combines with the
+ * destination through `blit_rgn1_rop2()`. Destination and source must not
+ * share storage.
+ * \param result Pointer to the destination scan structure.
+ * \param x Pointer to the one-dimensional region structure for the x-axis.
+ * \param y Pointer to the one-dimensional region structure for the y-axis.
+ * \param source Pointer to the source scan structure.
+ * \param rotate The rotation.
+ * \param rop2 The raster operation code.
+ * \return The number of logic operations performed, counted as for
+ * `blit_rgn1_rop2()`.
+ */
+int blit_rgn1_rotate(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, enum blit_rotate rotate,
+                     enum blit_rop2 rop2);
+
+/*!
+ * \brief Convenience function for rotating a rectangle of a scan into another
+ * scan.
+ * \param result Pointer to the destination scan structure.
+ * \param x The x-coordinate of the rotated rectangle's top-left corner.
+ * \param y The y-coordinate of the rotated rectangle's top-left corner.
+ * \param x_extent The extent of the rotated rectangle in the x-axis.
+ * \param y_extent The extent of the rotated rectangle in the y-axis.
+ * \param source Pointer to the source scan structure.
+ * \param x_source The x-coordinate of the source rectangle's top-left corner.
+ * \param y_source The y-coordinate of the source rectangle's top-left corner.
+ * \param rotate The rotation.
+ * \param rop2 The raster operation code.
+ * \return The number of logic operations performed.
+ */
+int blit_rotate(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source,
+                const int x_source, const int y_source, enum blit_rotate rotate, enum blit_rop2 rop2);
+
+#endif /* __BLIT_ROTATE_H__ */
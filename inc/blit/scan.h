@@ -13,6 +13,7 @@
 #ifndef __BLIT_SCAN_H__
 #define __BLIT_SCAN_H__
 
+#include <stddef.h>
 #include <stdint.h>
 
 /*!
@@ -23,6 +24,8 @@
  */
 typedef uint8_t blit_scanline_t;
 
+struct blit_damage;
+
 /*!
  * \brief Scanline structure.
  * \details The `blit_scan` structure represents a scanline buffer used in
@@ -55,8 +58,29 @@ struct blit_scan {
    * least \c width bytes.
    */
   int stride;
+  /*!
+   * \brief Damage accumulator, or null.
+   * \details When non-null, raster operations that write the scan add their
+   * clipped rectangles to it. See `blit/damage.h`.
+   * \note Must be null unless tracking damage. Any initialiser, including
+   * `BLIT_SCAN_INIT` and one written for the four members before it, leaves
+   * it null; a scan filled in member by member on the stack or heap must set
+   * it.
+   */
+  struct blit_damage *damage;
 };
 
+/*!
+ * \brief Macro to initialise a scanline structure over existing storage.
+ * \details Expands to a brace initialiser for a `blit_scan` structure with no
+ * damage accumulator.
+ * \param store Pointer to the scanline data buffer.
+ * \param width The width of the scanline buffer in pixels.
+ * \param height The height of the scanline buffer in pixels.
+ * \param stride The number of bytes between the start of each row.
+ */
+#define BLIT_SCAN_INIT(store, width, height, stride) {(store), (width), (height), (stride), NULL}
+
 /*!
  * \brief Macro to define a scanline structure with storage.
  * \details This macro defines a scanline structure along with its associated
@@ -70,9 +94,9 @@ struct blit_scan {
  * \note The stride is automatically calculated based on the width, ensuring
  * that it is sufficient to hold the specified number of pixels.
  */
-#define BLIT_SCAN_DEFINE(name, width, height)                                                                                                                  \
-  blit_scanline_t name##_store[(((width) + 7) >> 3) * (height)];                                                                                               \
-  struct blit_scan name = {name##_store, (width), (height), ((width) + 7) >> 3}
+#define BLIT_SCAN_DEFINE(name, width, height)                    \
+  blit_scanline_t name##_store[(((width) + 7) >> 3) * (height)]; \
+  struct blit_scan name = BLIT_SCAN_INIT(name##_store, (width), (height), ((width) + 7) >> 3)
 
 /*!
  * \brief Macro to define a static scanline structure with storage.
@@ -87,9 +111,9 @@ struct blit_scan {
  * \note The stride is automatically calculated based on the width, ensuring
  * that it is sufficient to hold the specified number of pixels.
  */
-#define BLIT_SCAN_DEFINE_STATIC(name, width, height)                                                                                                           \
-  static blit_scanline_t name##_store[(((width) + 7) >> 3) * (height)];                                                                                        \
-  static struct blit_scan name = {name##_store, (width), (height), ((width) + 7) >> 3}
+#define BLIT_SCAN_DEFINE_STATIC(name, width, height)                    \
+  static blit_scanline_t name##_store[(((width) + 7) >> 3) * (height)]; \
+  static struct blit_scan name = BLIT_SCAN_INIT(name##_store, (width), (height), ((width) + 7) >> 3)
 
 /*!
  * \brief Find the pointer to a specific bit in the scanline buffer.
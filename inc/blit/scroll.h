@@ -0,0 +1,45 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/scroll.h
+ * \brief Scrolling within a scan.
+ * \details This header file declares the function for scrolling a rectangle
+ * of a scan in place. Scrolling moves the rectangle's contents by a given
+ * offset, discards whatever moves out of the rectangle, and fills the strips
+ * that the move exposes.
+ */
+
+#ifndef __BLIT_SCROLL_H__
+#define __BLIT_SCROLL_H__
+
+#include <blit/rop2.h>
+
+/*!
+ * \brief Scrolls a rectangle of a scan in place.
+ * \details Moves the rectangle's contents by \c dx bits to the right and \c dy
+ * rows down; negative offsets move left and up. Bits that move outside the
+ * rectangle disappear. The function then fills the exposed strips, those the
+ * move leaves behind, with set or clear bits.
+ *
+ * The move works in place. The bit block transfer sees that destination and
+ * source overlap and picks a safe direction, so no temporary scan is needed.
+ * The exposed strips do not overlap the moved area; each byte is written once,
+ * apart from bytes shared at the strip edges. Moving and filling happen in one
+ * call but as separate passes: first the move, then the exposed rows, then
+ * the exposed columns.
+ * \param scan Pointer to the scan structure.
+ * \param x The x-coordinate of the rectangle's origin.
+ * \param y The y-coordinate of the rectangle's origin.
+ * \param x_extent The extent of the rectangle in the x-axis.
+ * \param y_extent The extent of the rectangle in the y-axis.
+ * \param dx Bits to move right, or left if negative.
+ * \param dy Rows to move down, or up if negative.
+ * \param fill True to fill exposed strips with set bits, false to clear them.
+ * \return The number of logic operations performed, moving and filling, or 0
+ * if the rectangle lies outside the scan.
+ */
+int blit_scroll(struct blit_scan *scan, int x, int y, int x_extent, int y_extent, int dx, int dy, bool fill);
+
+#endif /* __BLIT_SCROLL_H__ */
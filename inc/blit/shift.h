@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/shift.h
+ * \brief Pre-shifted source cache.
+ * \details This header file declares a cache of source scans shifted to
+ * other bit phases. A sprite blitted over and over at arbitrary horizontal
+ * positions needs at most eight copies, one per phase; with the right copy,
+ * every blit takes the aligned fetch path instead of shifting and merging
+ * every byte.
+ *
+ * The cache holds its copies in fixed slots carved from storage that the
+ * caller supplies, so its memory never grows. When every slot is busy, the
+ * least-recently used copy makes way.
+ */
+
+#ifndef __BLIT_SHIFT_H__
+#define __BLIT_SHIFT_H__
+
+#include <blit/rop2.h>
+
+#include <stddef.h>
+
+/*!
+ * \brief Number of cache slots.
+ * \details Enough for every phase of one source by default.
+ */
+#ifndef BLIT_SHIFT_SLOT_MAX
+#define BLIT_SHIFT_SLOT_MAX 8
+#endif
+
+/*!
+ * \brief Cache slot structure.
+ */
+struct blit_shift_slot {
+  /*!
+   * \brief Store of the source scan copied, or \c NULL if the slot is free.
+   */
+  const blit_scanline_t *key;
+  /*!
+   * \brief Bits by which the copy shifts the source right, from 1 to 7.
+   */
+  int shift;
+  /*!
+   * \brief Time of last use, for least-recently-used eviction.
+   */
+  unsigned long used;
+  /*!
+   * \brief The shifted copy.
+   * \details Source pixel \e x lives at pixel `x + shift` of the copy.
+   */
+  struct blit_scan scan;
+};
+
+/*!
+ * \brief Shift cache structure.
+ */
+struct blit_shift_cache {
+  /*!
+   * \brief Storage for the slots' copies.
+   */
+  blit_scanline_t *store;
+  /*!
+   * \brief Bytes of storage per slot.
+   */
+  size_t slot_size;
+  /*!
+   * \brief Slots.
+   */
+  struct blit_shift_slot slots[BLIT_SHIFT_SLOT_MAX];
+  /*!
+   * \brief Clock for least-recently-used eviction.
+   */
+  unsigned long clock;
+  /*!
+   * \brief Number of look-ups answered by a copy already made.
+   */
+  unsigned long hits;
+  /*!
+   * \brief Number of look-ups that made a new copy.
+   */
+  unsigned long misses;
+};
+
+/*!
+ * \brief Starts a shift cache.
+ * \details Divides the storage equally between the slots. Sources whose
+ * copies would not fit in one slot bypass the cache.
+ * \param cache Pointer to the cache structure.
+ * \param store Storage for the copies, owned by the caller.
+ * \param size Size of the storage in bytes.
+ */
+void blit_shift_cache_start(struct blit_shift_cache *cache, blit_scanline_t *store, size_t size);
+
+/*!
+ * \brief Forgets every copy of a source.
+ * \details The cache cannot see changes to its sources. Call this after
+ * changing a source's pixels, or before reusing its storage for another.
+ * \param cache Pointer to the cache structure.
+ * \param source Pointer to the source scan structure.
+ */
+void blit_shift_cache_forget(struct blit_shift_cache *cache, const struct blit_scan *source);
+
+/*!
+ * \brief Finds or makes a shifted copy of a source.
+ * \param cache Pointer to the cache structure.
+ * \param source Pointer to the source scan structure.
+ * \param shift Bits to shift right, from 1 to 7.
+ * \return Pointer to the shifted copy, or \c NULL if the shift is out of
+ * range or the copy cannot fit in a slot.
+ */
+const struct blit_scan *blit_shift_cache_find(struct blit_shift_cache *cache, const struct blit_scan *source, int shift);
+
+/*!
+ * \brief Perform raster operation on regions of scans through a shift cache.
+ * \details Behaves exactly as `blit_rgn1_rop2()`. When the destination and
+ * source phases differ, the blit reads from a copy of the source shifted to
+ * the destination's phase instead, found in or added to the cache. Sources
+ * sharing the destination's storage bypass the cache.
+ * \param result Pointer to the destination scan structure.
+ * \param x Pointer to the one-dimensional region structure for the x-axis.
+ * \param y Pointer to the one-dimensional region structure for the y-axis.
+ * \param source Pointer to the source scan structure.
+ * \param cache Pointer to the cache structure.
+ * \param rop2 The raster operation code.
+ * \return The number of logic operations performed.
+ */
+int blit_rgn1_rop2_shifted(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, struct blit_shift_cache *cache,
+                           enum blit_rop2 rop2);
+
+/*!
+ * \brief Convenience function for performing raster operations through a
+ * shift cache.
+ * \param result Pointer to the destination scan structure.
+ * \param x The x-coordinate of the origin of the region in the destination.
+ * \param y The y-coordinate of the origin of the region in the destination.
+ * \param x_extent The extent of the region in the x-axis.
+ * \param y_extent The extent of the region in the y-axis.
+ * \param source Pointer to the source scan structure.
+ * \param x_source The x-coordinate of the origin of the region in the source.
+ * \param y_source The y-coordinate of the origin of the region in the source.
+ * \param cache Pointer to the cache structure.
+ * \param rop2 The raster operation code.
+ * \return The number of logic operations performed.
+ */
+int blit_rop2_shifted(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source,
+                      const int x_source, const int y_source, struct blit_shift_cache *cache, enum blit_rop2 rop2);
+
+#endif /* __BLIT_SHIFT_H__ */
@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/span.h
+ * \brief Unmasked scanline span kernels.
+ * \details This header file declares the span kernels that apply a binary
+ * raster operation across a run of whole destination bytes, the unmasked
+ * middle of a scanline between its origin and extent bytes. A kernel fetches
+ * its source through a left funnel shift, to which every phase mode reduces:
+ * a right shift by \em n bits is a left shift by `8 - n` bits starting one
+ * byte earlier. See `blit_span_fetch_start()` and `blit_span_fetch_run()`.
+ *
+ * Kernels exist in portable C and, on x86 hosts, for SSE2, AVX2 and AVX-512.
+ * The library queries the processor the first time it needs a kernel and
+ * selects the widest instruction set available. A single binary therefore
+ * runs on every host, fast where it can be.
+ */
+
+#ifndef __BLIT_SPAN_H__
+#define __BLIT_SPAN_H__
+
+#include <blit/phase_align.h>
+#include <blit/rop2.h>
+
+/*!
+ * \brief Type definition for a span kernel function pointer.
+ * \details A span kernel stores `count` bytes starting at `store`. Each byte is
+ * the raster operation of the destination byte and the source byte funnel
+ * shifted left by `shift` bits from `fetch`. A non-zero shift reads one source
+ * byte beyond the span. The kernel works from left to right and reads each
+ * source byte before storing over it, so the destination may overlap the
+ * source provided that it does not start after it.
+ */
+typedef void (*blit_span_func_t)(blit_scanline_t *store, const blit_scanline_t *fetch, int shift, int count);
+
+/*!
+ * \brief Enumeration of span kernel instruction sets.
+ * \details Higher values are wider and preferred.
+ */
+enum blit_span_isa {
+  blit_span_isa_portable,
+  blit_span_isa_sse2,
+  blit_span_isa_avx2,
+  blit_span_isa_avx512,
+};
+
+/*!
+ * \brief Answers the span kernel for a raster operation.
+ * \details Selects the widest supported instruction set on first use.
+ * \param rop2 The raster operation code.
+ * \return Span kernel function for the selected instruction set.
+ */
+blit_span_func_t blit_span_func(enum blit_rop2 rop2);
+
+/*!
+ * \brief Answers the reverse span kernel for a raster operation.
+ * \details A reverse kernel stores the same bytes as its forward
+ * counterpart, but works from right to left. The destination may therefore
+ * overlap the source provided that it starts after it, as when scrolling
+ * right within a scanline. Reverse kernels are portable only; overlapping
+ * scanlines are the exception rather than the rule.
+ * \param rop2 The raster operation code.
+ * \return Reverse span kernel function.
+ */
+blit_span_func_t blit_span_reverse_func(enum blit_rop2 rop2);
+
+/*!
+ * \brief Answers the selected span kernel instruction set.
+ * \return The instruction set whose kernels `blit_span_func()` answers.
+ */
+enum blit_span_isa blit_span_isa_selected(void);
+
+/*!
+ * \brief Tests whether the host supports an instruction set.
+ * \details Checks both that the library has kernels for the instruction set
+ * and that the processor and operating system support it.
+ * \param isa The instruction set.
+ * \retval true if the host can run the instruction set's kernels.
+ * \retval false if it cannot.
+ */
+bool blit_span_isa_supported(enum blit_span_isa isa);
+
+/*!
+ * \brief Selects an instruction set for all subsequent span kernels.
+ * \details Useful for testing and for measuring the kernels against each
+ * other. Safe to call while other threads blit, though a blit already
+ * running may finish with the kernels it started with.
+ * \param isa The instruction set.
+ * \retval true if selected.
+ * \retval false if the host does not support the instruction set, in which
+ * case the selection does not change.
+ */
+bool blit_span_isa_select(enum blit_span_isa isa);
+
+/*!
+ * \brief Tests whether the processor has a population-count instruction.
+ * \details Shares the span instruction sets' processor probe, which runs
+ * once.
+ * \retval true if it does.
+ * \retval false if it does not, or the processor is not x86.
+ */
+bool blit_span_cpu_popcnt(void);
+
+/*!
+ * \brief Phase-aligned source fetch.
+ * \details Fetches runs of phase-aligned source bytes into a buffer, for
+ * operations that combine more than one operand with the destination. The
+ * fetch rules match the binary transfer loops: a left funnel shift for every
+ * byte, except that the first byte of a right shift has nothing before it and
+ * the last byte of a scanline leaves out any source byte beyond
+ * \c fetch_count. It therefore reads no source byte that the binary loops do
+ * not.
+ */
+struct blit_span_fetch {
+  /*!
+   * \brief First source byte of the first scanline.
+   */
+  const blit_scanline_t *fetch;
+  /*!
+   * \brief Phase mode.
+   */
+  enum blit_phase_align_mode mode;
+  /*!
+   * \brief Phase shift.
+   */
+  int shift;
+  /*!
+   * \brief Number of source bytes per scanline.
+   */
+  int fetch_count;
+  /*!
+   * \brief Number of destination bytes per scanline, less one.
+   */
+  int extra_scan_count;
+  /*!
+   * \brief Copy kernel for the bytes between the first and the last.
+   */
+  blit_span_func_t span;
+};
+
+/*!
+ * \brief Starts a phase-aligned source fetch.
+ * \param fetch Pointer to the fetch structure to start.
+ * \param x Destination bit position of the first bit.
+ * \param x_source Source bit position of the first bit.
+ * \param extent Number of bits per scanline, at least one.
+ * \param store Pointer to the source byte holding the first bit of the first
+ * scanline.
+ */
+void blit_span_fetch_start(struct blit_span_fetch *fetch, int x, int x_source, int extent, const blit_scanline_t *store);
+
+/*!
+ * \brief Fetches a run of phase-aligned source bytes.
+ * \details Fetches bytes \c k0 through `k0 + count - 1` of one scanline,
+ * byte 0 being the destination byte holding the first bit.
+ * \param fetch Pointer to the started fetch structure.
+ * \param store Pointer to the scanline's first source byte: the structure's
+ * \c fetch member offset by whole source strides.
+ * \param k0 First byte.
+ * \param count Number of bytes.
+ * \param run Receives the bytes.
+ */
+void blit_span_fetch_run(const struct blit_span_fetch *fetch, const blit_scanline_t *store, int k0, int count, blit_scanline_t *run);
+
+#endif /* __BLIT_SPAN_H__ */
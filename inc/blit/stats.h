@@ -0,0 +1,141 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/stats.h
+ * \brief Hot-path statistics.
+ * \details This header file declares the statistics that builds with the
+ * `BLIT_STATS` option gather inside `blit_rgn1_rop2()`: calls, rejections by
+ * region moving and clipping, scanlines, masked edge stores against unmasked
+ * interior stores, phase modes and time. They show which call sites cause
+ * narrow, unaligned, edge-heavy traffic.
+ *
+ * Statistics accumulate globally and, optionally, into a structure captured
+ * by the calling thread, for example around a single call. Builds without the
+ * option gather nothing; the functions still exist and answer zeros.
+ *
+ * The global counters add atomically, so threads may blit concurrently.
+ * Transfers that the worker pool runs in bands count once, in full, on the
+ * calling thread; the pool's threads add nothing themselves.
+ */
+
+#ifndef __BLIT_STATS_H__
+#define __BLIT_STATS_H__
+
+#include <stdint.h>
+
+/*!
+ * \brief Enumeration of statistics counters.
+ */
+enum blit_stats_counter {
+  /*!
+   * \brief Calls, including rejected calls.
+   */
+  blit_stats_calls,
+  /*!
+   * \brief Calls rejected because a region moved entirely out of positive
+   * space.
+   */
+  blit_stats_rejected_move,
+  /*!
+   * \brief Calls rejected because a region clipped to nothing.
+   */
+  blit_stats_rejected_clip,
+  /*!
+   * \brief Calls handed to the unary operations because they ignore the
+   * source.
+   */
+  blit_stats_source_free,
+  /*!
+   * \brief Scanlines transferred.
+   */
+  blit_stats_rows,
+  /*!
+   * \brief Masked stores of origin and extent bytes.
+   */
+  blit_stats_edge_stores,
+  /*!
+   * \brief Unmasked stores of interior bytes.
+   */
+  blit_stats_interior_stores,
+  /*!
+   * \brief Calls fetching with a left shift.
+   */
+  blit_stats_phase_left_shift,
+  /*!
+   * \brief Calls fetching without a shift.
+   */
+  blit_stats_phase_none,
+  /*!
+   * \brief Calls fetching with a right shift.
+   */
+  blit_stats_phase_right_shift,
+  /*!
+   * \brief Calls run in bands on the worker pool.
+   */
+  blit_stats_parallel,
+  /*!
+   * \brief Nanoseconds inside calls that were not rejected.
+   */
+  blit_stats_ns,
+  blit_stats_counter_max,
+};
+
+/*!
+ * \brief Statistics structure.
+ * \details Index the counts by `enum blit_stats_counter`. Zero-initialise
+ * before capturing.
+ */
+struct blit_stats {
+  uint64_t count[blit_stats_counter_max];
+};
+
+/*!
+ * \brief Copies the global statistics.
+ * \details Reads each counter atomically but not all of them at once, so a
+ * copy taken while other threads blit may mix counts from calls in progress.
+ * Threads wanting their own consistent counts should capture them.
+ * \param stats Receives the statistics.
+ */
+void blit_stats_read(struct blit_stats *stats);
+
+/*!
+ * \brief Zeroes the global statistics.
+ */
+void blit_stats_reset(void);
+
+/*!
+ * \brief Captures the calling thread's statistics.
+ * \details Subsequent calls on the calling thread add to \c stats as well as
+ * to the global statistics, until the next capture.
+ * \param stats Pointer to the structure to add to, or null to stop capturing.
+ * \return The previously captured structure, or null.
+ */
+struct blit_stats *blit_stats_capture(struct blit_stats *stats);
+
+/*!
+ * \brief Adds to a counter.
+ * \details Raster operations count through `BLIT_STATS_COUNT()` so that
+ * builds without statistics compile the counting away.
+ * \param counter The counter.
+ * \param n The amount to add.
+ */
+void blit_stats_count(enum blit_stats_counter counter, uint64_t n);
+
+/*!
+ * \brief Answers a monotonic clock in nanoseconds.
+ */
+uint64_t blit_stats_clock(void);
+
+#ifdef BLIT_STATS
+#define BLIT_STATS_COUNT(counter, n) blit_stats_count((counter), (uint64_t)(n))
+#define BLIT_STATS_CLOCK(name) const uint64_t name = blit_stats_clock()
+#define BLIT_STATS_ELAPSED(name) blit_stats_count(blit_stats_ns, blit_stats_clock() - (name))
+#else
+#define BLIT_STATS_COUNT(counter, n) ((void)0)
+#define BLIT_STATS_CLOCK(name) ((void)0)
+#define BLIT_STATS_ELAPSED(name) ((void)0)
+#endif
+
+#endif /* __BLIT_STATS_H__ */
@@ -0,0 +1,67 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/stretch.h
+ * \brief Integer scaling blits.
+ * \details This header file declares the nearest-neighbour stretch blit:
+ * enlarging by whole factors, such as 2×, 3× and 4× for higher-density
+ * panels, or reducing by taking every \e n th pixel, applying any binary
+ * raster operation at the destination.
+ */
+
+#ifndef __BLIT_STRETCH_H__
+#define __BLIT_STRETCH_H__
+
+#include <blit/rop2.h>
+
+/*!
+ * \brief Perform a scaling raster operation on regions of scans.
+ * \details A scale of \e n greater than 1 enlarges by \e n: each source pixel
+ * becomes \e n destination pixels. A scale of `-n` for \e n greater than 1
+ * reduces by \e n: each destination pixel takes every \e n th source pixel.
+ * Scales of 1 and -1 copy one for one.
+ *
+ * The extents count destination pixels and must be positive. Clipping works
+ * in destination pixels against both scans, so nothing is scaled that falls
+ * outside either. On return, the regions hold the clipped destination
+ * region, with source origins at the source pixels that the first
+ * destination pixels take.
+ *
+ * Enlarging spreads each source byte through a bit-doubling table for scales
+ * up to 8, in column chunks; enlarging vertically runs one staged row across
+ * all the destination rows that repeat it, in one transfer. The transfers go
+ * through `blit_rgn1_rop2()`. Destination and source must not share storage.
+ * \param result Pointer to the destination scan structure.
+ * \param x Pointer to the one-dimensional region structure for the x-axis.
+ * \param y Pointer to the one-dimensional region structure for the y-axis.
+ * \param source Pointer to the source scan structure.
+ * \param x_scale Horizontal scale.
+ * \param y_scale Vertical scale.
+ * \param rop2 The raster operation code.
+ * \return The number of logic operations performed, counted as for
+ * `blit_rgn1_rop2()`.
+ */
+int blit_rgn1_stretch(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, int x_scale, int y_scale,
+                      enum blit_rop2 rop2);
+
+/*!
+ * \brief Convenience function for performing scaling raster operations.
+ * \param result Pointer to the destination scan structure.
+ * \param x The x-coordinate of the origin of the region.
+ * \param y The y-coordinate of the origin of the region.
+ * \param x_extent The extent of the destination region in the x-axis.
+ * \param y_extent The extent of the destination region in the y-axis.
+ * \param source Pointer to the source scan structure.
+ * \param x_source The x-coordinate of the origin of the source region.
+ * \param y_source The y-coordinate of the origin of the source region.
+ * \param x_scale Horizontal scale.
+ * \param y_scale Vertical scale.
+ * \param rop2 The raster operation code.
+ * \return The number of logic operations performed.
+ */
+int blit_stretch(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source,
+                 const int x_source, const int y_source, int x_scale, int y_scale, enum blit_rop2 rop2);
+
+#endif /* __BLIT_STRETCH_H__ */
@@ -0,0 +1,146 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/text.h
+ * \brief Glyph atlases and text runs.
+ * \details This header file declares bitmap fonts, whose glyphs live side by
+ * side in one atlas scan, and the text-run renderer that draws a string of
+ * them in one call. The run clips against the destination once, as a whole.
+ * Narrow glyphs that fall wholly inside the destination and the atlas skip
+ * the general clip and phase set-up; they go a scanline at a time through
+ * one 32-bit shift and mask.
+ */
+
+#ifndef __BLIT_TEXT_H__
+#define __BLIT_TEXT_H__
+
+#include <blit/rop2.h>
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*!
+ * \brief Widest glyph, in pixels, that takes the narrow-glyph path.
+ * \details A scanline of the glyph at any bit phase fits in 32 bits. Wider
+ * glyphs draw through `blit_rgn1_rop2()`.
+ */
+#define BLIT_TEXT_NARROW 25
+
+/*!
+ * \brief Glyph structure.
+ * \details Locates a glyph in its font's atlas and places it relative to the
+ * pen.
+ */
+struct blit_glyph {
+  /*!
+   * \brief Left of the glyph in the atlas.
+   */
+  int x_atlas;
+  /*!
+   * \brief Top of the glyph in the atlas.
+   */
+  int y_atlas;
+  /*!
+   * \brief Width of the glyph in pixels, possibly zero.
+   */
+  int width;
+  /*!
+   * \brief Height of the glyph in scanlines, possibly zero.
+   */
+  int height;
+  /*!
+   * \brief Horizontal offset of the glyph's left from the pen.
+   */
+  int x_offset;
+  /*!
+   * \brief Vertical offset of the glyph's top from the pen.
+   */
+  int y_offset;
+  /*!
+   * \brief Horizontal distance that the pen moves after the glyph.
+   */
+  int advance;
+};
+
+/*!
+ * \brief Font structure.
+ * \details Maps a contiguous range of character codes to glyphs. Characters
+ * outside the range draw nothing and do not move the pen.
+ */
+struct blit_font {
+  /*!
+   * \brief Scan holding every glyph.
+   */
+  const struct blit_scan *atlas;
+  /*!
+   * \brief Glyph for each character, starting at the first.
+   */
+  const struct blit_glyph *glyph;
+  /*!
+   * \brief Character code of the first glyph.
+   */
+  int first;
+  /*!
+   * \brief Number of glyphs.
+   */
+  int count;
+  /*!
+   * \brief Optional pre-shifted glyph scanlines, or \c NULL for none.
+   * \details Set by `blit_font_shift()`.
+   */
+  const uint32_t *shifted;
+  /*!
+   * \brief Scanlines per glyph in the pre-shifted cache.
+   */
+  int shifted_height;
+};
+
+/*!
+ * \brief Number of 32-bit words that a font's pre-shifted cache needs.
+ * \details Eight words, one for each destination bit phase, for every
+ * scanline of every glyph, counting every glyph as tall as the tallest.
+ * \param font Pointer to the font structure.
+ * \return The number of words.
+ */
+size_t blit_font_shift_count(const struct blit_font *font);
+
+/*!
+ * \brief Builds a font's pre-shifted cache.
+ * \details Shifts every scanline of every narrow glyph to each of the eight
+ * destination bit phases, so that drawing the glyph reads one word per
+ * scanline with no shifting. The font uses the cache from then on; the
+ * caller owns the storage, which must outlive the font's use.
+ * \param font Pointer to the font structure.
+ * \param shifted Storage for at least `blit_font_shift_count(font)` words.
+ */
+void blit_font_shift(struct blit_font *font, uint32_t *shifted);
+
+/*!
+ * \brief Width of a text run.
+ * \param font Pointer to the font structure.
+ * \param text The characters.
+ * \param length Number of characters.
+ * \return The sum of the advances.
+ */
+int blit_text_width(const struct blit_font *font, const char *text, int length);
+
+/*!
+ * \brief Draws a text run.
+ * \details Each glyph goes through the raster operation, with the glyph as
+ * source, at the pen plus the glyph's offsets; the pen then advances. The
+ * run adds its damage once, as the bounds of its glyphs clipped to the
+ * destination, unless the operation is `blit_rop2_D`.
+ * \param result Pointer to the destination scan structure.
+ * \param x The x-coordinate of the pen.
+ * \param y The y-coordinate of the pen.
+ * \param font Pointer to the font structure.
+ * \param text The characters.
+ * \param length Number of characters.
+ * \param rop2 The raster operation code.
+ * \return The number of logic operations performed.
+ */
+int blit_text(struct blit_scan *result, int x, int y, const struct blit_font *font, const char *text, int length, enum blit_rop2 rop2);
+
+#endif /* __BLIT_TEXT_H__ */
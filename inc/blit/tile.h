@@ -0,0 +1,60 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/tile.h
+ * \brief Tiled pattern fills.
+ * \details This header file declares the functions that tile a small pattern
+ * scan across a destination rectangle in one call, with any binary raster
+ * operation, the pattern standing in for the source.
+ */
+
+#ifndef __BLIT_TILE_H__
+#define __BLIT_TILE_H__
+
+#include <blit/brush.h>
+#include <blit/rop2.h>
+
+/*!
+ * \brief Tile a pattern across a region of a scan.
+ * \details Clips the regions against the destination only; the brush tiles
+ * the whole destination plane. Expands each pattern row once into a
+ * byte-aligned repeating buffer, then streams the buffer through the span
+ * kernel across every destination row that shares the pattern row. Wide
+ * regions go in chunks so that the buffer stays in cache.
+ *
+ * Tiling is equivalent to one `blit_rgn1_rop2()` per tile, without the
+ * per-tile clipping and phase alignment. Operations that ignore the source
+ * go to `blit_rgn1_rop1()`.
+ * \param result Pointer to the destination scan structure.
+ * \param x Pointer to the one-dimensional region structure for the x-axis.
+ * The source origin follows the origin.
+ * \param y Pointer to the one-dimensional region structure for the y-axis.
+ * The source origin follows the origin.
+ * \param brush Pointer to the pattern brush.
+ * \param rop2 The raster operation code, with the pattern as source.
+ * \return The number of logic operations performed, counted as for
+ * `blit_rgn1_rop2()`, or 0 without touching the scan if the pattern is
+ * empty.
+ */
+int blit_rgn1_tile(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_brush *brush, enum blit_rop2 rop2);
+
+/*!
+ * \brief Convenience function for tiling a pattern.
+ * \param result Pointer to the destination scan structure.
+ * \param x The x-coordinate of the origin of the region.
+ * \param y The y-coordinate of the origin of the region.
+ * \param x_extent The extent of the region in the x-axis.
+ * \param y_extent The extent of the region in the y-axis.
+ * \param pattern Pointer to the pattern scan.
+ * \param x_pattern The destination x-coordinate of pattern pixel 0.
+ * \param y_pattern The destination y-coordinate of pattern row 0.
+ * \param rop2 The raster operation code.
+ * \return The number of logic operations performed, or 0 if the pattern is
+ * empty.
+ */
+int blit_tile(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *pattern,
+              const int x_pattern, const int y_pattern, enum blit_rop2 rop2);
+
+#endif /* __BLIT_TILE_H__ */
@@ -0,0 +1,137 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/word.h
+ * \brief Native machine words for wide scanline spans.
+ * \details This header file defines the `blit_word_t` type and inline
+ * functions for loading, storing and funnel-shifting whole machine words of
+ * scanline bytes. The bit block transfer uses words across the inner span of
+ * each scanline, between the masked origin and extent bytes.
+ *
+ * Scanline bytes run most-significant bit first. A word loaded from memory
+ * holds bytes in host order, little- or big-endian. The functions here never
+ * move bits across a byte lane; every shift masks each byte lane
+ * independently. Host byte order therefore never matters, and words stored
+ * back hold exactly the bytes that byte-at-a-time processing would have
+ * produced.
+ */
+
+#ifndef __BLIT_WORD_H__
+#define __BLIT_WORD_H__
+
+#include <blit/scan.h>
+
+#include <string.h>
+
+/*!
+ * \brief Type definition for a native machine word of scanline bytes.
+ * \details The word is 64 bits wide on hosts with 64-bit pointers, and 32
+ * bits wide otherwise.
+ */
+#if UINTPTR_MAX > 0xffffffffU
+typedef uint64_t blit_word_t;
+#else
+typedef uint32_t blit_word_t;
+#endif
+
+/*!
+ * \brief Number of scanline bytes in a machine word.
+ */
+#define BLIT_WORD_BYTES ((int)sizeof(blit_word_t))
+
+/*!
+ * \brief Replicates a byte across every byte lane of a word.
+ * \param byte The byte to replicate.
+ * \return Word with every byte lane equal to \c byte.
+ */
+static inline blit_word_t blit_word_splat(blit_scanline_t byte) { return ((blit_word_t)-1 / 0xffU) * byte; }
+
+/*!
+ * \brief Loads a word from possibly unaligned scanline storage.
+ * \param store Pointer to the first byte of the word.
+ * \return The loaded word in host byte order.
+ */
+static inline blit_word_t blit_word_load(const blit_scanline_t *store) {
+  blit_word_t word;
+  (void)memcpy(&word, store, sizeof(word));
+  return word;
+}
+
+/*!
+ * \brief Stores a word to possibly unaligned scanline storage.
+ * \param store Pointer to the first byte of the word.
+ * \param word The word to store in host byte order.
+ */
+static inline void blit_word_store(blit_scanline_t *store, blit_word_t word) { (void)memcpy(store, &word, sizeof(word)); }
+
+/*!
+ * \brief Funnel-shifts a scanline byte.
+ * \details Answers the byte made from the low `8 - shift` bits of the first
+ * byte followed by the high \c shift bits of the second byte. A zero shift
+ * answers the first byte without reading the second.
+ * \param fetch Pointer to the first byte.
+ * \param shift Left shift in bits, 0 through 7.
+ * \return The funnel-shifted byte.
+ */
+static inline blit_scanline_t blit_funnel(const blit_scanline_t *fetch, int shift) {
+  return shift == 0 ? fetch[0] : (blit_scanline_t)((fetch[0] << shift) | (fetch[1] >> (8 - shift)));
+}
+
+/*!
+ * \brief Funnel-shifts a word of scanline bytes.
+ * \details Answers the same bytes as `BLIT_WORD_BYTES` successive calls to
+ * `blit_funnel()`. Two overlapping loads supply the high and low parts of
+ * each byte lane; masks discard the bits that the shifts carry across lanes.
+ * A non-zero shift reads one byte beyond the word.
+ * \param fetch Pointer to the first byte.
+ * \param shift Left shift in bits, 0 through 7.
+ * \return The funnel-shifted word.
+ */
+static inline blit_word_t blit_word_funnel(const blit_scanline_t *fetch, int shift) {
+  if (shift == 0)
+    return blit_word_load(fetch);
+  return ((blit_word_load(fetch) << shift) & blit_word_splat((blit_scanline_t)(0xffU << shift))) |
+         ((blit_word_load(fetch + 1) >> (8 - shift)) & blit_word_splat((blit_scanline_t)(0xffU >> (8 - shift))));
+}
+
+/*!
+ * \brief Reverses the bits of each byte lane of a word.
+ * \details Three swaps, of neighbouring bits, pairs and nibbles, each
+ * masked within byte lanes. The lanes stay where they are.
+ * \param word The word.
+ * \return The word with every byte's bits in reverse order.
+ */
+static inline blit_word_t blit_word_reverse(blit_word_t word) {
+  word = ((word >> 1) & blit_word_splat(0x55U)) | ((word & blit_word_splat(0x55U)) << 1);
+  word = ((word >> 2) & blit_word_splat(0x33U)) | ((word & blit_word_splat(0x33U)) << 2);
+  return ((word >> 4) & blit_word_splat(0x0fU)) | ((word & blit_word_splat(0x0fU)) << 4);
+}
+
+/*!
+ * \brief Reverses the byte lanes of a word.
+ * \details Loading a word, swapping it and storing it reverses the order of
+ * its bytes in memory, whatever the host byte order.
+ * \param word The word.
+ * \return The word with its byte lanes in reverse order.
+ */
+static inline blit_word_t blit_word_swap(blit_word_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+  return sizeof(word) == 8 ? (blit_word_t)__builtin_bswap64(word) : (blit_word_t)__builtin_bswap32((uint32_t)word);
+#else
+  blit_word_t swapped = 0U;
+  for (int lane = 0; lane < BLIT_WORD_BYTES; lane++, word >>= 8)
+    swapped = (swapped << 8) | (word & 0xffU);
+  return swapped;
+#endif
+}
+
+/*!
+ * \brief Reverses the bits of a scanline byte.
+ * \param byte The byte.
+ * \return The byte with its bits in reverse order.
+ */
+static inline blit_scanline_t blit_reverse(blit_scanline_t byte) { return (blit_scanline_t)blit_word_reverse(byte); }
+
+#endif /* __BLIT_WORD_H__ */
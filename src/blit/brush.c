@@ -0,0 +1,61 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/brush.c
+ * \brief Tiled pattern brushes.
+ * \details This source file implements brush expansion, as declared in the
+ * `blit/brush.h` header file.
+ */
+
+#include <blit/brush.h>
+
+#include <string.h>
+
+/*!
+ * \brief Answers the non-negative remainder.
+ * \param a The dividend, of any sign.
+ * \param m The divisor, positive.
+ * \return Remainder from 0 through `m - 1`.
+ */
+static inline int brush_mod(int a, int m) {
+  const int r = a % m;
+  return r < 0 ? r + m : r;
+}
+
+void blit_brush_expand(const struct blit_brush *brush, int x, int y, blit_scanline_t *store, int count) {
+  const struct blit_scan *pattern = brush->pattern;
+  const int width = pattern->width;
+  const blit_scanline_t *row = blit_scan_find(pattern, 0, brush_mod(y - brush->y, pattern->height));
+  const int phase = brush_mod(x - brush->x, width);
+  const int period = width / (width & 7 ? (width & 3 ? (width & 1 ? 1 : 2) : 4) : 8);
+  int n = period < count ? period : count;
+
+  if ((width & 7) == 0) {
+    /*
+     * Whole pattern bytes. Byte k starts at pattern bit phase + 8k, wrapping at
+     * the end of the row, and the bits within a byte never straddle the wrap.
+     */
+    const int shift = phase & 7;
+    for (int k = 0, j = phase >> 3; k < n; k++, j = j + 1 == period ? 0 : j + 1)
+      store[k] = shift == 0 ? row[j] : (blit_scanline_t)((row[j] << shift) | (row[j + 1 == period ? 0 : j + 1] >> (8 - shift)));
+  } else {
+    for (int k = 0, u = phase; k < n; k++) {
+      blit_scanline_t byte = 0x00U;
+      for (int bit = 0; bit < 8; bit++, u = u + 1 == width ? 0 : u + 1)
+        byte = (blit_scanline_t)((byte << 1) | ((row[u >> 3] >> (7 - (u & 7))) & 1));
+      store[k] = byte;
+    }
+  }
+
+  /*
+   * The first n bytes hold whole periods. Copying them along doubles the run
+   * of whole periods each time, until the last copy fills what remains.
+   */
+  while (n < count) {
+    const int m = n < count - n ? n : count - n;
+    (void)memcpy(store + n, store, (size_t)m);
+    n += m;
+  }
+}
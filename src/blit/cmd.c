@@ -0,0 +1,281 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/cmd.c
+ * \brief Batched blit command lists.
+ * \details This source file implements the command list functions declared
+ * in the `blit/cmd.h` header file.
+ */
+
+#include <blit/cmd.h>
+
+#include <stddef.h>
+#include <string.h>
+
+/*!
+ * \brief Destination bytes per band.
+ * \details Small enough that a band of the widest destination stays in the
+ * first- or second-level cache while every command touching it runs.
+ */
+#define CMD_BAND_BYTES 16384
+
+/*!
+ * \brief Number of earlier commands that an opaque command looks back over
+ * for commands it covers.
+ */
+#define CMD_COVER_WINDOW 64
+
+/*!
+ * \brief Maximum number of distinct destinations checked for aliasing.
+ * \details Lists writing more destinations than this run in record order.
+ */
+#define CMD_RESULT_MAX 8
+
+int blit_cmd_rop2(struct blit_cmd_list *list, struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent,
+                  const struct blit_scan *source, const int x_source, const int y_source, enum blit_rop2 rop2) {
+  if (list->count == list->capacity)
+    return -1;
+  struct blit_cmd *cmd = list->cmds + list->count;
+  cmd->result = result;
+  cmd->source = source;
+  cmd->x = (struct blit_rgn1){.origin = x, .extent = x_extent, .origin_source = x_source};
+  cmd->y = (struct blit_rgn1){.origin = y, .extent = y_extent, .origin_source = y_source};
+  cmd->rop2 = rop2;
+  cmd->logic_count = 0;
+  cmd->live = false;
+
+  /*
+   * Clip exactly as the binary raster operation does, once, now.
+   */
+  blit_rgn1_norm(&cmd->x);
+  blit_rgn1_norm(&cmd->y);
+  if (blit_rgn1_move(&cmd->x) && blit_rgn1_clip(&cmd->x, result->width - cmd->x.origin) && blit_rgn1_clip(&cmd->x, source->width - cmd->x.origin_source) &&
+      blit_rgn1_move(&cmd->y) && blit_rgn1_clip(&cmd->y, result->height - cmd->y.origin) && blit_rgn1_clip(&cmd->y, source->height - cmd->y.origin_source)) {
+    const int x_max = cmd->x.origin + cmd->x.extent - 1;
+    cmd->logic_count = cmd->y.extent * ((x_max >> 3) - (cmd->x.origin >> 3) + 1);
+    cmd->live = true;
+  }
+  return list->count++;
+}
+
+/*!
+ * \brief Tests whether two scans share any storage.
+ */
+static bool cmd_scan_overlap(const struct blit_scan *scan, const struct blit_scan *other) {
+  return scan->store < other->store + other->stride * other->height && other->store < scan->store + scan->stride * scan->height;
+}
+
+/*!
+ * \brief Tests whether any live command reads storage that a live command
+ * writes.
+ * \details Also tests whether two different destination scans share storage.
+ * Banding, dropping and merging match destinations by scan, so two scans over
+ * the same rows would let their commands run out of record order.
+ */
+static bool cmd_list_aliases(const struct blit_cmd_list *list) {
+  const struct blit_scan *results[CMD_RESULT_MAX];
+  int result_count = 0;
+  for (int i = 0; i < list->count; i++) {
+    const struct blit_cmd *cmd = list->cmds + i;
+    if (!cmd->live)
+      continue;
+    int j = 0;
+    while (j < result_count && !cmd_scan_overlap(cmd->result, results[j]))
+      j++;
+    if (j < result_count) {
+      if (results[j] != cmd->result)
+        return true;
+    } else {
+      if (result_count == CMD_RESULT_MAX)
+        return true;
+      results[result_count++] = cmd->result;
+    }
+  }
+  for (int i = 0; i < list->count; i++) {
+    const struct blit_cmd *cmd = list->cmds + i;
+    if (!cmd->live)
+      continue;
+    for (int j = 0; j < result_count; j++)
+      if (cmd_scan_overlap(cmd->source, results[j]))
+        return true;
+  }
+  return false;
+}
+
+/*!
+ * \brief Tests whether a raster operation ignores the destination.
+ * \details Such an operation overwrites everything it covers.
+ */
+static inline bool cmd_opaque(enum blit_rop2 rop2) { return ((rop2 >> 1) & 5) == (rop2 & 5); }
+
+/*!
+ * \brief Tests whether one region covers another.
+ */
+static inline bool cmd_rgn1_covers(const struct blit_rgn1 *rgn1, const struct blit_rgn1 *other) {
+  return rgn1->origin <= other->origin && other->origin + other->extent <= rgn1->origin + rgn1->extent;
+}
+
+/*!
+ * \brief Tests whether one region continues another, in both destination and
+ * source.
+ */
+static inline bool cmd_rgn1_continues(const struct blit_rgn1 *rgn1, const struct blit_rgn1 *other) {
+  return rgn1->origin == other->origin + other->extent && rgn1->origin_source == other->origin_source + other->extent;
+}
+
+static inline bool cmd_rgn1_equal(const struct blit_rgn1 *rgn1, const struct blit_rgn1 *other) {
+  return rgn1->origin == other->origin && rgn1->extent == other->extent && rgn1->origin_source == other->origin_source;
+}
+
+/*!
+ * \brief Drops commands that a later opaque command covers.
+ * \details Without aliasing, nothing reads what the covered command writes
+ * before the opaque command overwrites it.
+ */
+static void cmd_list_drop(struct blit_cmd_list *list) {
+  for (int i = 1; i < list->count; i++) {
+    const struct blit_cmd *cmd = list->cmds + i;
+    if (!cmd->live || !cmd_opaque(cmd->rop2))
+      continue;
+    for (int j = i - 1; j >= 0 && j >= i - CMD_COVER_WINDOW; j--) {
+      struct blit_cmd *covered = list->cmds + j;
+      if (covered->live && covered->result == cmd->result && cmd_rgn1_covers(&cmd->x, &covered->x) && cmd_rgn1_covers(&cmd->y, &covered->y))
+        covered->live = false;
+    }
+  }
+}
+
+/*!
+ * \brief Merges each live command into the live command before it where the
+ * two make one rectangle.
+ * \details Same destination, source and operation, side by side or one above
+ * the other, with the source rectangles side by side or one above the other
+ * in the same way.
+ */
+static void cmd_list_merge(struct blit_cmd_list *list) {
+  struct blit_cmd *last = NULL;
+  for (int i = 0; i < list->count; i++) {
+    struct blit_cmd *cmd = list->cmds + i;
+    if (!cmd->live)
+      continue;
+    if (last != NULL && last->result == cmd->result && last->source == cmd->source && last->rop2 == cmd->rop2) {
+      if (cmd_rgn1_equal(&cmd->y, &last->y) && cmd_rgn1_continues(&cmd->x, &last->x)) {
+        last->x.extent += cmd->x.extent;
+        cmd->live = false;
+        continue;
+      }
+      if (cmd_rgn1_equal(&cmd->x, &last->x) && cmd_rgn1_continues(&cmd->y, &last->y)) {
+        last->y.extent += cmd->y.extent;
+        cmd->live = false;
+        continue;
+      }
+    }
+    last = cmd;
+  }
+}
+
+int blit_cmd_list_run(struct blit_cmd_list *list) {
+  int logic_count = 0;
+  for (int i = 0; i < list->count; i++)
+    logic_count += list->cmds[i].logic_count;
+
+  if (cmd_list_aliases(list)) {
+    for (int i = 0; i < list->count; i++) {
+      const struct blit_cmd *cmd = list->cmds + i;
+      if (!cmd->live)
+        continue;
+      struct blit_rgn1 x = cmd->x, y = cmd->y;
+      (void)blit_rgn1_rop2(cmd->result, &x, &y, cmd->source, cmd->rop2);
+    }
+    return logic_count;
+  }
+
+  cmd_list_drop(list);
+  cmd_list_merge(list);
+
+  /*
+   * Band the rows. Every pixel still sees its commands in record order, since
+   * within a band the commands run in record order and no command reads what
+   * another writes.
+   */
+  int y_min = 0, y_max = 0, stride = 1;
+  bool any = false;
+  for (int i = 0; i < list->count; i++) {
+    const struct blit_cmd *cmd = list->cmds + i;
+    if (!cmd->live)
+      continue;
+    if (!any || cmd->y.origin < y_min)
+      y_min = cmd->y.origin;
+    if (!any || cmd->y.origin + cmd->y.extent > y_max)
+      y_max = cmd->y.origin + cmd->y.extent;
+    if (cmd->result->stride > stride)
+      stride = cmd->result->stride;
+    any = true;
+  }
+  const int band = CMD_BAND_BYTES / stride > 1 ? CMD_BAND_BYTES / stride : 1;
+  for (int y0 = y_min; y0 < y_max; y0 += band) {
+    const int y1 = y0 + band;
+    for (int i = 0; i < list->count; i++) {
+      const struct blit_cmd *cmd = list->cmds + i;
+      if (!cmd->live || cmd->y.origin >= y1 || cmd->y.origin + cmd->y.extent <= y0)
+        continue;
+      const int origin = cmd->y.origin > y0 ? cmd->y.origin : y0;
+      const int end = cmd->y.origin + cmd->y.extent < y1 ? cmd->y.origin + cmd->y.extent : y1;
+      struct blit_rgn1 x = cmd->x;
+      struct blit_rgn1 y = {
+          .origin = origin,
+          .extent = end - origin,
+          .origin_source = cmd->y.origin_source + origin - cmd->y.origin,
+      };
+      (void)blit_rgn1_rop2(cmd->result, &x, &y, cmd->source, cmd->rop2);
+    }
+  }
+  return logic_count;
+}
+
+int blit_cmd_list_band(struct blit_cmd_list *list, const struct blit_scan *page, struct blit_scan *band, blit_cmd_band_func_t func, void *context) {
+  if (band->width < page->width || band->height <= 0)
+    return 0;
+  int logic_count = 0;
+  for (int i = 0; i < list->count; i++) {
+    if (list->cmds[i].result != page || list->cmds[i].source == page)
+      return 0;
+    logic_count += list->cmds[i].logic_count;
+  }
+
+  /*
+   * Nothing reads the page, so dropping and merging are always safe.
+   */
+  cmd_list_drop(list);
+  cmd_list_merge(list);
+
+  for (int y0 = 0; y0 < page->height; y0 += band->height) {
+    const int rows = page->height - y0 < band->height ? page->height - y0 : band->height;
+    struct blit_scan scan = BLIT_SCAN_INIT(band->store, page->width, rows, band->stride);
+    (void)memset(scan.store, 0, (size_t)scan.stride * (size_t)rows);
+    for (int i = 0; i < list->count; i++) {
+      const struct blit_cmd *cmd = list->cmds + i;
+      if (!cmd->live || cmd->y.origin >= y0 + rows || cmd->y.origin + cmd->y.extent <= y0)
+        continue;
+
+      /*
+       * Trim the rows above the band, clip those below it, then shift the
+       * destination into band coordinates.
+       */
+      struct blit_rgn1 x = cmd->x, y = cmd->y;
+      if (y.origin < y0) {
+        y.extent -= y0 - y.origin;
+        y.origin_source += y0 - y.origin;
+        y.origin = y0;
+      }
+      (void)blit_rgn1_clip(&y, y0 + rows - y.origin);
+      y.origin -= y0;
+      (void)blit_rgn1_rop2(&scan, &x, &y, cmd->source, cmd->rop2);
+    }
+    if (!(*func)(context, &scan, y0))
+      break;
+  }
+  return logic_count;
+}
@@ -0,0 +1,218 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/count.c
+ * \brief Set-pixel statistics over regions.
+ * \details This source file implements the queries declared in the
+ * `blit/count.h` header file.
+ */
+
+#include <blit/count.h>
+#include <blit/span.h>
+#include <blit/word.h>
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define BLIT_COUNT_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BLIT_TARGET(isa)
+#else
+#define BLIT_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+/*!
+ * \brief Type definition for a counting kernel.
+ * \details Answers the number of set bits in \c count bytes at \c store.
+ */
+typedef uint64_t (*count_func_t)(const blit_scanline_t *store, int count);
+
+/*!
+ * \brief Counts the set bits of a word by bit slicing.
+ * \details Sums bit pairs, then nybbles, then bytes; one multiply gathers
+ * the byte sums into the top byte.
+ */
+static inline int count_word(blit_word_t word) {
+  word -= (word >> 1) & blit_word_splat(0x55U);
+  word = (word & blit_word_splat(0x33U)) + ((word >> 2) & blit_word_splat(0x33U));
+  word = (word + (word >> 4)) & blit_word_splat(0x0fU);
+  return (int)((word * blit_word_splat(0x01U)) >> (8 * (BLIT_WORD_BYTES - 1)));
+}
+
+static uint64_t count_portable(const blit_scanline_t *store, int count) {
+  uint64_t bits = 0U;
+  int k = 0;
+  for (; k + BLIT_WORD_BYTES <= count; k += BLIT_WORD_BYTES)
+    bits += (uint64_t)count_word(blit_word_load(store + k));
+  for (; k < count; k++)
+    bits += (uint64_t)count_word(store[k]);
+  return bits;
+}
+
+#ifdef BLIT_COUNT_X86
+BLIT_TARGET("popcnt")
+static uint64_t count_popcnt(const blit_scanline_t *store, int count) {
+  uint64_t bits = 0U;
+  int k = 0;
+  for (; k + 8 <= count; k += 8) {
+    uint64_t word;
+    (void)memcpy(&word, store + k, sizeof(word));
+#if defined(_MSC_VER) && defined(_M_X64)
+    bits += __popcnt64(word);
+#elif defined(_MSC_VER)
+    bits += __popcnt((unsigned int)word) + __popcnt((unsigned int)(word >> 32));
+#else
+    bits += (uint64_t)__builtin_popcountll(word);
+#endif
+  }
+  for (; k < count; k++)
+    bits += (uint64_t)count_word(store[k]);
+  return bits;
+}
+#endif
+
+/*!
+ * \brief Selects the counting kernel.
+ * \details Follows the span kernels: portable when they are portable,
+ * otherwise the population-count instruction if the processor has it. The
+ * span kernels' processor probe answers that.
+ */
+static count_func_t count_func(void) {
+#ifdef BLIT_COUNT_X86
+  if (blit_span_isa_selected() != blit_span_isa_portable && blit_span_cpu_popcnt())
+    return count_popcnt;
+#endif
+  return count_portable;
+}
+
+/*!
+ * \brief Finds the first set pixel of a masked byte run.
+ * \return Its x-coordinate, or -1.
+ */
+static int count_first(const blit_scanline_t *store, int x_byte, int count, blit_scanline_t origin_mask, blit_scanline_t extent_mask) {
+  for (int k = 0; k < count; k++) {
+    if (k > 0 && k + BLIT_WORD_BYTES < count && blit_word_load(store + k) == 0U) {
+      k += BLIT_WORD_BYTES - 1;
+      continue;
+    }
+    blit_scanline_t byte = store[k];
+    if (k == 0)
+      byte &= origin_mask;
+    if (k == count - 1)
+      byte &= extent_mask;
+    if (byte == 0U)
+      continue;
+    int x = (x_byte + k) << 3;
+    for (; (byte & 0x80U) == 0U; byte <<= 1)
+      x++;
+    return x;
+  }
+  return -1;
+}
+
+/*!
+ * \brief Finds the last set pixel of a masked byte run.
+ * \return Its x-coordinate, or -1.
+ */
+static int count_last(const blit_scanline_t *store, int x_byte, int count, blit_scanline_t origin_mask, blit_scanline_t extent_mask) {
+  for (int k = count - 1; k >= 0; k--) {
+    if (k < count - 1 && k - BLIT_WORD_BYTES >= 0 && blit_word_load(store + k - (BLIT_WORD_BYTES - 1)) == 0U) {
+      k -= BLIT_WORD_BYTES - 1;
+      continue;
+    }
+    blit_scanline_t byte = store[k];
+    if (k == 0)
+      byte &= origin_mask;
+    if (k == count - 1)
+      byte &= extent_mask;
+    if (byte == 0U)
+      continue;
+    int x = ((x_byte + k) << 3) + 7;
+    for (; (byte & 0x01U) == 0U; byte >>= 1)
+      x--;
+    return x;
+  }
+  return -1;
+}
+
+uint64_t blit_rgn1_count(const struct blit_scan *scan, struct blit_rgn1 *x, struct blit_rgn1 *y, struct blit_count *count, int *first, int *last) {
+  if (count != NULL) {
+    count->count = 0U;
+    count->x = count->y = count->x_extent = count->y_extent = 0;
+  }
+  x->origin_source = x->origin;
+  blit_rgn1_norm(x);
+  if (!blit_rgn1_move(x) || !blit_rgn1_clip(x, scan->width - x->origin))
+    return 0U;
+  y->origin_source = y->origin;
+  blit_rgn1_norm(y);
+  if (!blit_rgn1_move(y) || !blit_rgn1_clip(y, scan->height - y->origin))
+    return 0U;
+
+  /*
+   * Mask the edge bytes; count the bytes between them whole.
+   */
+  const int x_max = x->origin + x->extent - 1;
+  const int extra_scan_count = (x_max >> 3) - (x->origin >> 3);
+  blit_scanline_t origin_mask = 0xffU >> (x->origin & 7);
+  blit_scanline_t extent_mask = 0xffU << (7 - (x_max & 7));
+  if (extra_scan_count == 0)
+    origin_mask = extent_mask = origin_mask & extent_mask;
+  const count_func_t func = count_func();
+  const bool bounds = count != NULL || first != NULL || last != NULL;
+  int x_min = scan->width, x_end = -1, y_min = -1, y_end = -1;
+  uint64_t bits = 0U;
+  const blit_scanline_t *store = blit_scan_find(scan, x->origin, y->origin);
+  for (int v = 0; v < y->extent; v++, store += scan->stride) {
+    uint64_t row = (uint64_t)count_word(store[0] & origin_mask);
+    if (extra_scan_count > 0) {
+      row += (*func)(store + 1, extra_scan_count - 1);
+      row += (uint64_t)count_word(store[extra_scan_count] & extent_mask);
+    }
+    bits += row;
+    if (!bounds)
+      continue;
+    const int row_first = row == 0U ? -1 : count_first(store, x->origin >> 3, extra_scan_count + 1, origin_mask, extent_mask);
+    const int row_last = row == 0U ? -1 : count_last(store, x->origin >> 3, extra_scan_count + 1, origin_mask, extent_mask);
+    if (first != NULL)
+      first[v] = row_first;
+    if (last != NULL)
+      last[v] = row_last;
+    if (row == 0U)
+      continue;
+    if (row_first < x_min)
+      x_min = row_first;
+    if (row_last > x_end)
+      x_end = row_last;
+    if (y_min < 0)
+      y_min = y->origin + v;
+    y_end = y->origin + v;
+  }
+  if (count != NULL && bits != 0U) {
+    count->count = bits;
+    count->x = x_min;
+    count->y = y_min;
+    count->x_extent = x_end - x_min + 1;
+    count->y_extent = y_end - y_min + 1;
+  }
+  return bits;
+}
+
+uint64_t blit_count(const struct blit_scan *scan, const int x, const int y, const int x_extent, const int y_extent, struct blit_count *count) {
+  struct blit_rgn1 x_rgn1 = {
+      .origin = x,
+      .extent = x_extent,
+      .origin_source = x,
+  };
+  struct blit_rgn1 y_rgn1 = {
+      .origin = y,
+      .extent = y_extent,
+      .origin_source = y,
+  };
+  return blit_rgn1_count(scan, &x_rgn1, &y_rgn1, count, NULL, NULL);
+}
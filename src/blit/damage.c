@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/damage.c
+ * \brief Damage tracking.
+ * \details This source file implements the damage accumulator declared in the
+ * `blit/damage.h` header file.
+ */
+
+#include <blit/damage.h>
+
+static inline bool damage_covers(const struct blit_damage_rect *rect, const struct blit_damage_rect *other) {
+  return rect->x <= other->x && other->x + other->x_extent <= rect->x + rect->x_extent && rect->y <= other->y &&
+         other->y + other->y_extent <= rect->y + rect->y_extent;
+}
+
+/*!
+ * \brief Tests whether two rectangles make one rectangle together.
+ * \details True when they share both edges across one axis and touch or
+ * overlap along the other.
+ */
+static inline bool damage_joins(const struct blit_damage_rect *rect, const struct blit_damage_rect *other) {
+  if (rect->y == other->y && rect->y_extent == other->y_extent)
+    return rect->x <= other->x + other->x_extent && other->x <= rect->x + rect->x_extent;
+  if (rect->x == other->x && rect->x_extent == other->x_extent)
+    return rect->y <= other->y + other->y_extent && other->y <= rect->y + rect->y_extent;
+  return false;
+}
+
+static void damage_union(struct blit_damage_rect *rect, const struct blit_damage_rect *other) {
+  const int x_end = rect->x + rect->x_extent > other->x + other->x_extent ? rect->x + rect->x_extent : other->x + other->x_extent;
+  const int y_end = rect->y + rect->y_extent > other->y + other->y_extent ? rect->y + rect->y_extent : other->y + other->y_extent;
+  if (other->x < rect->x)
+    rect->x = other->x;
+  if (other->y < rect->y)
+    rect->y = other->y;
+  rect->x_extent = x_end - rect->x;
+  rect->y_extent = y_end - rect->y;
+}
+
+void blit_damage_add(struct blit_damage *damage, int x, int y, int x_extent, int y_extent) {
+  if (x_extent <= 0 || y_extent <= 0)
+    return;
+  struct blit_damage_rect rect = {x, y, x_extent, y_extent};
+
+  /*
+   * Merging may make the new rectangle join one that it did not join before,
+   * so start over after every merge.
+   */
+  for (int i = 0; i < damage->count;) {
+    const struct blit_damage_rect *other = damage->rects + i;
+    if (damage_covers(other, &rect))
+      return;
+    if (damage_covers(&rect, other) || damage_joins(&rect, other)) {
+      damage_union(&rect, other);
+      damage->rects[i] = damage->rects[--damage->count];
+      i = 0;
+      continue;
+    }
+    i++;
+  }
+
+  if (damage->count == BLIT_DAMAGE_RECT_MAX) {
+    for (int i = 0; i < damage->count; i++)
+      damage_union(&rect, damage->rects + i);
+    damage->count = 0;
+  }
+  damage->rects[damage->count++] = rect;
+}
+
+bool blit_damage_bounds(const struct blit_damage *damage, struct blit_damage_rect *bounds) {
+  if (damage->count == 0)
+    return false;
+  *bounds = damage->rects[0];
+  for (int i = 1; i < damage->count; i++)
+    damage_union(bounds, damage->rects + i);
+  return true;
+}
@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/depth.c
+ * \brief Packed multi-bit pixels.
+ * \details This source file implements the packed-pixel operations declared
+ * in the `blit/depth.h` header file.
+ */
+
+#include <blit/depth.h>
+#include <blit/tile.h>
+
+/*!
+ * \brief Tests for a supported depth.
+ */
+static bool depth_valid(int depth) { return depth == 1 || depth == 2 || depth == 4 || depth == 8; }
+
+int blit_rgn1_rop2_depth(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, int depth, enum blit_rop2 rop2) {
+  if (!depth_valid(depth))
+    return 0;
+  blit_rgn1_depth(x, depth);
+  const int logic_count = blit_rgn1_rop2(result, x, y, source, rop2);
+  x->origin /= depth;
+  x->extent /= depth;
+  x->origin_source /= depth;
+  return logic_count;
+}
+
+int blit_rop2_depth(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source,
+                    const int x_source, const int y_source, int depth, enum blit_rop2 rop2) {
+  if (!depth_valid(depth))
+    return 0;
+  return blit_rop2(result, x * depth, y, x_extent * depth, y_extent, source, x_source * depth, y_source, rop2);
+}
+
+int blit_fill_depth(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, int depth, unsigned int pixel,
+                    enum blit_rop2 rop2) {
+  if (!depth_valid(depth))
+    return 0;
+  static const blit_scanline_t replicate[] = {0, 0xffU, 0x55U, 0, 0x11U, 0, 0, 0, 0x01U};
+  BLIT_SCAN_DEFINE(pattern, 8, 1);
+  pattern.store[0] = (blit_scanline_t)((pixel & ((1U << depth) - 1U)) * replicate[depth]);
+  return blit_tile(result, x * depth, y, x_extent * depth, y_extent, &pattern, 0, 0, rop2);
+}
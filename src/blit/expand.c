@@ -0,0 +1,174 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/expand.c
+ * \brief Colour expansion to chunky pixels.
+ * \details This source file implements the colour expansion declared in the
+ * `blit/expand.h` header file.
+ */
+
+#include <blit/expand.h>
+#include <blit/span.h>
+
+#include <string.h>
+
+/*!
+ * \brief Number of source bytes fetched per chunk.
+ */
+#define EXPAND_CHUNK 256
+
+/*!
+ * \brief Pixel mask tables.
+ * \details Each entry is 64 bits of pixels, all ones where the matching
+ * source bit is 1 and all zeros where it is 0, the most-significant source
+ * bit first in memory. Eight 8-bit pixels take a whole byte of source bits,
+ * four 16-bit pixels a nibble, two 32-bit pixels a pair of bits. The entries
+ * are arrays of pixels rather than 64-bit words so that their layout in
+ * memory is the same whatever the byte order.
+ */
+#define EXPAND_BIT(bits, u, n, ones) ((((bits) >> ((n) - 1 - (u))) & 1) ? (ones) : 0U)
+#define EXPAND_MASK8(bits)                                                                                                                                     \
+  {EXPAND_BIT(bits, 0, 8, 0xffU), EXPAND_BIT(bits, 1, 8, 0xffU), EXPAND_BIT(bits, 2, 8, 0xffU), EXPAND_BIT(bits, 3, 8, 0xffU),                               \
+   EXPAND_BIT(bits, 4, 8, 0xffU), EXPAND_BIT(bits, 5, 8, 0xffU), EXPAND_BIT(bits, 6, 8, 0xffU), EXPAND_BIT(bits, 7, 8, 0xffU)}
+#define EXPAND_MASK8_4(bits) EXPAND_MASK8(bits), EXPAND_MASK8((bits) + 1), EXPAND_MASK8((bits) + 2), EXPAND_MASK8((bits) + 3)
+#define EXPAND_MASK8_16(bits) EXPAND_MASK8_4(bits), EXPAND_MASK8_4((bits) + 4), EXPAND_MASK8_4((bits) + 8), EXPAND_MASK8_4((bits) + 12)
+#define EXPAND_MASK8_64(bits) EXPAND_MASK8_16(bits), EXPAND_MASK8_16((bits) + 16), EXPAND_MASK8_16((bits) + 32), EXPAND_MASK8_16((bits) + 48)
+#define EXPAND_MASK16(bits) {EXPAND_BIT(bits, 0, 4, 0xffffU), EXPAND_BIT(bits, 1, 4, 0xffffU), EXPAND_BIT(bits, 2, 4, 0xffffU), EXPAND_BIT(bits, 3, 4, 0xffffU)}
+#define EXPAND_MASK16_4(bits) EXPAND_MASK16(bits), EXPAND_MASK16((bits) + 1), EXPAND_MASK16((bits) + 2), EXPAND_MASK16((bits) + 3)
+#define EXPAND_MASK32(bits) {EXPAND_BIT(bits, 0, 2, 0xffffffffU), EXPAND_BIT(bits, 1, 2, 0xffffffffU)}
+
+static const uint8_t expand_mask8[256][8] = {EXPAND_MASK8_64(0), EXPAND_MASK8_64(64), EXPAND_MASK8_64(128), EXPAND_MASK8_64(192)};
+static const uint16_t expand_mask16[16][4] = {EXPAND_MASK16_4(0), EXPAND_MASK16_4(4), EXPAND_MASK16_4(8), EXPAND_MASK16_4(12)};
+static const uint32_t expand_mask32[4][2] = {EXPAND_MASK32(0), EXPAND_MASK32(1), EXPAND_MASK32(2), EXPAND_MASK32(3)};
+
+/*!
+ * \brief Expansion parameters.
+ * \details The colours replicate across 64 bits, one copy per pixel.
+ */
+struct expand {
+  uint64_t foreground;
+  uint64_t background;
+  bool transparent;
+};
+
+/*!
+ * \brief Stores 64 bits of pixels through a mask table entry.
+ */
+static void expand_store(const struct expand *e, uint8_t *store, const void *mask_pixels) {
+  uint64_t mask, pixels;
+  (void)memcpy(&mask, mask_pixels, sizeof(mask));
+  if (e->transparent) {
+    (void)memcpy(&pixels, store, sizeof(pixels));
+    pixels = (pixels & ~mask) | (e->foreground & mask);
+  } else {
+    pixels = (e->background & ~mask) | (e->foreground & mask);
+  }
+  (void)memcpy(store, &pixels, sizeof(pixels));
+}
+
+/*!
+ * \brief Stores one pixel.
+ */
+static void expand_pixel(const struct expand *e, uint8_t *store, int depth, int bit) {
+  if (!bit && e->transparent)
+    return;
+  const uint64_t pixel = bit ? e->foreground : e->background;
+  switch (depth) {
+  case 8:
+    *store = (uint8_t)pixel;
+    break;
+  case 16: {
+    const uint16_t pixel16 = (uint16_t)pixel;
+    (void)memcpy(store, &pixel16, sizeof(pixel16));
+    break;
+  }
+  default: {
+    const uint32_t pixel32 = (uint32_t)pixel;
+    (void)memcpy(store, &pixel32, sizeof(pixel32));
+  }
+  }
+}
+
+int blit_rgn1_expand(struct blit_chunky *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, uint32_t foreground,
+                     uint32_t background, bool transparent) {
+  const int depth = result->depth;
+  if (depth != 8 && depth != 16 && depth != 32)
+    return 0;
+  blit_rgn1_norm(x);
+  if (!blit_rgn1_move(x) || !blit_rgn1_clip(x, result->width - x->origin) || !blit_rgn1_clip(x, source->width - x->origin_source))
+    return 0;
+  blit_rgn1_norm(y);
+  if (!blit_rgn1_move(y) || !blit_rgn1_clip(y, result->height - y->origin) || !blit_rgn1_clip(y, source->height - y->origin_source))
+    return 0;
+
+  const uint64_t replicate = depth == 8 ? 0x0101010101010101U : depth == 16 ? 0x0001000100010001U : 0x0000000100000001U;
+  const uint64_t pixel_mask = depth == 32 ? 0xffffffffU : (1U << depth) - 1U;
+  const struct expand e = {
+      .foreground = (foreground & pixel_mask) * replicate,
+      .background = (background & pixel_mask) * replicate,
+      .transparent = transparent,
+  };
+  const int pixel_bytes = depth >> 3;
+
+  /*
+   * Fetch the source as if the destination started on a byte boundary: byte
+   * k of the run then holds pixels 8k through 8k + 7.
+   */
+  struct blit_span_fetch f;
+  blit_span_fetch_start(&f, 0, x->origin_source, x->extent, blit_scan_find(source, x->origin_source, y->origin_source));
+  const int whole_count = x->extent >> 3;
+  blit_scanline_t fetch_chunk[EXPAND_CHUNK];
+
+  const blit_scanline_t *fetch = f.fetch;
+  uint8_t *row = (uint8_t *)result->store + (ptrdiff_t)result->stride * y->origin + (ptrdiff_t)pixel_bytes * x->origin;
+  for (int extent = y->extent; extent--; row += result->stride, fetch += source->stride) {
+    for (int k0 = 0; k0 <= f.extra_scan_count; k0 += EXPAND_CHUNK) {
+      const int count = f.extra_scan_count + 1 - k0 < EXPAND_CHUNK ? f.extra_scan_count + 1 - k0 : EXPAND_CHUNK;
+      blit_span_fetch_run(&f, fetch, k0, count, fetch_chunk);
+      const int whole = whole_count - k0 < count ? whole_count - k0 : count;
+      uint8_t *store = row + (ptrdiff_t)k0 * 8 * pixel_bytes;
+      for (int k = 0; k < whole; k++) {
+        const blit_scanline_t bits = fetch_chunk[k];
+        switch (depth) {
+        case 8:
+          expand_store(&e, store, expand_mask8[bits]);
+          store += 8;
+          break;
+        case 16:
+          expand_store(&e, store, expand_mask16[bits >> 4]);
+          expand_store(&e, store + 8, expand_mask16[bits & 15]);
+          store += 16;
+          break;
+        default:
+          for (int shift = 6; shift >= 0; shift -= 2, store += 8)
+            expand_store(&e, store, expand_mask32[(bits >> shift) & 3]);
+        }
+      }
+
+      /*
+       * The last few pixels of the scanline, fewer than 8, go one at a time.
+       */
+      if (whole < count)
+        for (int u = 0; u < (x->extent & 7); u++, store += pixel_bytes)
+          expand_pixel(&e, store, depth, (fetch_chunk[whole] >> (7 - u)) & 1);
+    }
+  }
+  return x->extent * y->extent;
+}
+
+int blit_expand(struct blit_chunky *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source,
+                const int x_source, const int y_source, uint32_t foreground, uint32_t background, bool transparent) {
+  struct blit_rgn1 x_rgn1 = {
+      .origin = x,
+      .extent = x_extent,
+      .origin_source = x_source,
+  };
+  struct blit_rgn1 y_rgn1 = {
+      .origin = y,
+      .extent = y_extent,
+      .origin_source = y_source,
+  };
+  return blit_rgn1_expand(result, &x_rgn1, &y_rgn1, source, foreground, background, transparent);
+}
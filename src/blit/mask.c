@@ -0,0 +1,169 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/mask.c
+ * \brief Masked raster operations.
+ * \details This source file implements the masked raster operations declared
+ * in the `blit/mask.h` header file.
+ */
+
+#include <blit/damage.h>
+#include <blit/mask.h>
+#include <blit/span.h>
+#include <blit/word.h>
+
+#include <stdlib.h>
+
+#include "mux.h"
+
+/*!
+ * \brief Number of scanline bytes processed per chunk.
+ */
+#define MASK_CHUNK 256
+
+/*
+ * One masked evaluation, for words or for bytes.
+ */
+#define MASK_MUX(type, d, s, m)                                \
+  do {                                                         \
+    const type t0 = (type)mux->a[0] ^ ((type)mux->b[0] & (d)); \
+    const type t1 = (type)mux->a[1] ^ ((type)mux->b[1] & (d)); \
+    const type r = t0 ^ ((t0 ^ t1) & (s));                     \
+    (d) ^= (r ^ (d)) & (m);                                    \
+  } while (0)
+
+/*!
+ * \brief Applies a masked binary operation across a run of bytes.
+ * \param mux Pointer to the multiplexer masks.
+ * \param store Destination bytes, read and written.
+ * \param fetch Phase-aligned source bytes.
+ * \param mask Phase-aligned mask bytes.
+ * \param count Number of bytes.
+ */
+static void mask_span(const struct blit_mux *mux, blit_scanline_t *store, const blit_scanline_t *fetch, const blit_scanline_t *mask, int count) {
+  int k = 0;
+  for (; k + BLIT_WORD_BYTES <= count; k += BLIT_WORD_BYTES) {
+    blit_word_t d = blit_word_load(store + k);
+    const blit_word_t s = blit_word_load(fetch + k), m = blit_word_load(mask + k);
+    MASK_MUX(blit_word_t, d, s, m);
+    blit_word_store(store + k, d);
+  }
+  for (; k < count; k++)
+    MASK_MUX(blit_scanline_t, store[k], fetch[k], mask[k]);
+}
+
+int blit_rgn1_rop2_mask(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, const struct blit_scan *mask,
+                        int x_mask, int y_mask, enum blit_rop2 rop2) {
+  const bool uses_source = (rop2 >> 2) != (rop2 & 3);
+
+  /*
+   * Carry the mask origins as offsets from the region origins, which
+   * normalising moves. Then normalise, move, and clip the regions against the
+   * destination and the source. A second region pairs the destination with
+   * the mask; moving and clipping it moves and clips the first.
+   */
+  if (!uses_source) {
+    x->origin_source = x->origin;
+    y->origin_source = y->origin;
+  }
+  x_mask -= x->origin;
+  y_mask -= y->origin;
+  blit_rgn1_norm(x);
+  if (!blit_rgn1_move(x) || !blit_rgn1_clip(x, result->width - x->origin) ||
+      (uses_source && !blit_rgn1_clip(x, source->width - x->origin_source)))
+    return 0;
+  struct blit_rgn1 x_rgn1 = {.origin = x->origin, .extent = x->extent, .origin_source = x->origin + x_mask};
+  if (!blit_rgn1_move(&x_rgn1) || !blit_rgn1_clip(&x_rgn1, mask->width - x_rgn1.origin_source))
+    return 0;
+  x->origin_source += x_rgn1.origin - x->origin;
+  x->origin = x_rgn1.origin;
+  x->extent = x_rgn1.extent;
+  blit_rgn1_norm(y);
+  if (!blit_rgn1_move(y) || !blit_rgn1_clip(y, result->height - y->origin) ||
+      (uses_source && !blit_rgn1_clip(y, source->height - y->origin_source)))
+    return 0;
+  struct blit_rgn1 y_rgn1 = {.origin = y->origin, .extent = y->extent, .origin_source = y->origin + y_mask};
+  if (!blit_rgn1_move(&y_rgn1) || !blit_rgn1_clip(&y_rgn1, mask->height - y_rgn1.origin_source))
+    return 0;
+  y->origin_source += y_rgn1.origin - y->origin;
+  y->origin = y_rgn1.origin;
+  y->extent = y_rgn1.extent;
+
+  const int x_max = x->origin + x->extent - 1;
+  const int extra_scan_count = (x_max >> 3) - (x->origin >> 3);
+  const int logic_count = y->extent * (extra_scan_count + 1);
+  if (rop2 == blit_rop2_D)
+    return logic_count;
+
+  blit_scan_damage(result, x, y);
+
+  int y_store = y->origin, y_fetch = y->origin_source, y_step = 1;
+  bool reverse = false;
+
+  /*
+   * Overlap, as for ternary operations: bottom up when moving down, chunk by
+   * chunk right to left when moving right within the same scanlines.
+   */
+  if (uses_source && result->store == source->store && abs(y->origin - y->origin_source) < y->extent &&
+      abs(x->origin - x->origin_source) < x->extent) {
+    if (y->origin > y->origin_source) {
+      y_store += y->extent - 1;
+      y_fetch += y->extent - 1;
+      y_step = -1;
+    } else if (y->origin == y->origin_source && x->origin > x->origin_source) {
+      reverse = true;
+    }
+  }
+
+  struct blit_span_fetch f = {.fetch = NULL}, m;
+  if (uses_source)
+    blit_span_fetch_start(&f, x->origin, x->origin_source, x->extent, blit_scan_find(source, x->origin_source, y_fetch));
+  blit_span_fetch_start(&m, x->origin, x_rgn1.origin_source, x->extent, blit_scan_find(mask, x_rgn1.origin_source, y_rgn1.origin_source + (y_store - y->origin)));
+
+  struct blit_mux mux;
+  blit_mux_start(&mux, rop2, 2);
+  blit_scanline_t origin_mask = 0xffU >> (x->origin & 7);
+  const blit_scanline_t extent_mask = 0xffU << (7 - (x_max & 7));
+  if (extra_scan_count == 0)
+    origin_mask &= extent_mask;
+  const int chunk_count = extra_scan_count / MASK_CHUNK + 1;
+  blit_scanline_t fetch_chunk[MASK_CHUNK], mask_chunk[MASK_CHUNK];
+
+  const blit_scanline_t *fetch = f.fetch, *fetch_mask = m.fetch;
+  for (int extent = y->extent; extent--; y_store += y_step) {
+    blit_scanline_t *store = blit_scan_find(result, x->origin, y_store);
+    for (int chunk = 0; chunk < chunk_count; chunk++) {
+      const int k0 = (reverse ? chunk_count - 1 - chunk : chunk) * MASK_CHUNK;
+      const int count = extra_scan_count + 1 - k0 < MASK_CHUNK ? extra_scan_count + 1 - k0 : MASK_CHUNK;
+      blit_span_fetch_run(&m, fetch_mask, k0, count, mask_chunk);
+      if (k0 == 0)
+        mask_chunk[0] &= origin_mask;
+      if (extra_scan_count > 0 && k0 + count > extra_scan_count)
+        mask_chunk[extra_scan_count - k0] &= extent_mask;
+      if (uses_source)
+        blit_span_fetch_run(&f, fetch, k0, count, fetch_chunk);
+      mask_span(&mux, store + k0, uses_source ? fetch_chunk : mask_chunk, mask_chunk, count);
+    }
+    if (uses_source)
+      fetch += y_step * source->stride;
+    fetch_mask += y_step * mask->stride;
+  }
+  return logic_count;
+}
+
+int blit_rop2_mask(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source,
+                   const int x_source, const int y_source, const struct blit_scan *mask, const int x_mask, const int y_mask, enum blit_rop2 rop2) {
+  struct blit_rgn1 x_rgn1 = {
+      .origin = x,
+      .extent = x_extent,
+      .origin_source = x_source,
+  };
+  struct blit_rgn1 y_rgn1 = {
+      .origin = y,
+      .extent = y_extent,
+      .origin_source = y_source,
+  };
+  return blit_rgn1_rop2_mask(result, &x_rgn1, &y_rgn1, source, mask, x_mask, y_mask, rop2);
+}
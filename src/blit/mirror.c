@@ -0,0 +1,172 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/mirror.c
+ * \brief Horizontally mirrored blits.
+ * \details This source file implements the mirrored raster operations
+ * declared in the `blit/mirror.h` header file.
+ */
+
+#include <blit/damage.h>
+#include <blit/mirror.h>
+#include <blit/rop1.h>
+#include <blit/word.h>
+
+/*!
+ * \brief Clips a mirrored x-axis region.
+ * \details Trimming one end of the destination trims the other end of the
+ * source, and the other way round.
+ * \retval true if anything remains.
+ */
+static bool mirror_clip(struct blit_rgn1 *x, int width, int width_source) {
+  if (x->origin < 0) {
+    x->extent += x->origin;
+    x->origin = 0;
+  }
+  if (x->origin_source < 0) {
+    x->extent += x->origin_source;
+    x->origin_source = 0;
+  }
+  if (x->origin + x->extent > width) {
+    const int trim = x->origin + x->extent - width;
+    x->extent -= trim;
+    x->origin_source += trim;
+  }
+  if (x->origin_source + x->extent > width_source) {
+    const int trim = x->origin_source + x->extent - width_source;
+    x->extent -= trim;
+    x->origin += trim;
+  }
+  return x->extent > 0;
+}
+
+/*!
+ * \brief Reverses source bytes \c first through \c last into a run.
+ * \details Byte \e k of the run is source byte `last - k` with its bits
+ * reversed. Whole words go at once; reads stay within the source bytes.
+ */
+static void mirror_reverse(blit_scanline_t *run, const blit_scanline_t *fetch, int first, int last) {
+  int k = 0;
+  for (; last - k - (BLIT_WORD_BYTES - 1) >= first; k += BLIT_WORD_BYTES)
+    blit_word_store(run + k, blit_word_swap(blit_word_reverse(blit_word_load(fetch + last - k - (BLIT_WORD_BYTES - 1)))));
+  for (; last - k >= first; k++)
+    run[k] = blit_reverse(fetch[last - k]);
+}
+
+/*!
+ * \brief Stages a column chunk of mirrored scanlines.
+ * \details Reverses the source pixels that destination pixels `x->origin +
+ * u` onwards take, \c count of them, on \c rows scanlines from \c y_source.
+ */
+static void mirror_stage(blit_scanline_t *stage, int stride, const struct blit_scan *source, const struct blit_rgn1 *x, int y_source, int rows, int u,
+                         int count) {
+  const int hi = x->origin_source + x->extent - 1 - u, lo = hi - count + 1;
+  for (int row = 0; row < rows; row++)
+    mirror_reverse(stage + row * stride, blit_scan_find(source, 0, y_source + row), lo >> 3, hi >> 3);
+}
+
+/*!
+ * \brief Transfers a staged column chunk to the destination.
+ */
+static void mirror_put(struct blit_scan *result, blit_scanline_t *stage, int stride, const struct blit_rgn1 *x, int y, int rows, int u, int count,
+                       enum blit_rop2 rop2) {
+  const int hi = x->origin_source + x->extent - 1 - u;
+  const struct blit_scan staged = BLIT_SCAN_INIT(stage, stride << 3, rows, stride);
+  (void)blit_rop2(result, x->origin + u, y, count, rows, &staged, 7 - (hi & 7), 0, rop2);
+}
+
+int blit_rgn1_rop2_mirror(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, enum blit_rop2 rop2) {
+  blit_rgn1_norm(x);
+  if (!mirror_clip(x, result->width, source->width))
+    return 0;
+  blit_rgn1_norm(y);
+  if (!blit_rgn1_move(y) || !blit_rgn1_clip(y, result->height - y->origin) || !blit_rgn1_clip(y, source->height - y->origin_source))
+    return 0;
+
+  /*
+   * Source-free operations do not care which way the source runs.
+   */
+  if ((rop2 >> 2) == (rop2 & 3)) {
+    struct blit_rgn1 x_rop1 = *x, y_rop1 = *y;
+    return blit_rgn1_rop1(result, &x_rop1, &y_rop1, (enum blit_rop1)(rop2 & 3));
+  }
+
+  blit_scan_damage(result, x, y);
+  struct blit_scan plain = *result;
+  plain.damage = NULL;
+  const bool shared = result->store == source->store;
+  const int chunk = ((x->extent + 7) >> 3) + 2 <= BLIT_MIRROR_STAGE ? x->extent : (BLIT_MIRROR_STAGE - 2) << 3;
+  const int stride = ((chunk + 7) >> 3) + 2;
+  blit_scanline_t stage[BLIT_MIRROR_STAGE];
+
+  if (shared && chunk != x->extent && y->origin == y->origin_source) {
+    /*
+     * Column chunks of scanlines mirrored onto themselves. Writing destination
+     * pixel i overwrites the source of pixel k - i, and only that pixel's, so
+     * chunks paired about k / 2 stage together, each half of the stage, and
+     * then transfer. Pixels past k read source outside the destination.
+     */
+    const int half = BLIT_MIRROR_STAGE / 2, pair = (half - 2) << 3;
+    const int k = x->extent - 1 - (x->origin - x->origin_source);
+    const int left = k < 0 ? 0 : (k / 2 + 1 < x->extent ? k / 2 + 1 : x->extent);
+    const int right = k + 1 > left ? k + 1 : left;
+    for (int v = 0; v < y->extent; v++) {
+      for (int u0 = 0; u0 < left; u0 += pair) {
+        const int u1 = left - u0 < pair ? left : u0 + pair;
+        const int w0 = k - u1 + 1 > left ? k - u1 + 1 : left, w1 = k - u0 + 1 < x->extent ? k - u0 + 1 : x->extent;
+        mirror_stage(stage, half, source, x, y->origin_source + v, 1, u0, u1 - u0);
+        if (w0 < w1)
+          mirror_stage(stage + half, half, source, x, y->origin_source + v, 1, w0, w1 - w0);
+        mirror_put(&plain, stage, half, x, y->origin + v, 1, u0, u1 - u0, rop2);
+        if (w0 < w1)
+          mirror_put(&plain, stage + half, half, x, y->origin + v, 1, w0, w1 - w0, rop2);
+      }
+      for (int u0 = right; u0 < x->extent; u0 += chunk) {
+        const int count = x->extent - u0 < chunk ? x->extent - u0 : chunk;
+        mirror_stage(stage, stride, source, x, y->origin_source + v, 1, u0, count);
+        mirror_put(&plain, stage, stride, x, y->origin + v, 1, u0, count, rop2);
+      }
+    }
+  } else {
+    /*
+     * Stage whole scanlines if they fit, then as many of them per band as
+     * fit. Otherwise, stage column chunks one scanline at a time. Moving down
+     * within shared storage, work bottom up so that no band overwrites rows
+     * that a later band reads; each band reads all its rows before writing
+     * any.
+     */
+    const int band = BLIT_MIRROR_STAGE / stride;
+    const bool bottom_up = shared && y->origin > y->origin_source;
+    for (int v0 = 0; v0 < y->extent; v0 += band) {
+      const int rows = y->extent - v0 < band ? y->extent - v0 : band;
+      const int v = bottom_up ? y->extent - v0 - rows : v0;
+      for (int u0 = 0; u0 < x->extent; u0 += chunk) {
+        const int count = x->extent - u0 < chunk ? x->extent - u0 : chunk;
+        mirror_stage(stage, stride, source, x, y->origin_source + v, rows, u0, count);
+        mirror_put(&plain, stage, stride, x, y->origin + v, rows, u0, count, rop2);
+      }
+    }
+  }
+
+  /*
+   * Count as `blit_rgn1_rop2()` does for the region, however it was chunked.
+   */
+  return y->extent * (((x->origin + x->extent - 1) >> 3) - (x->origin >> 3) + 1);
+}
+
+int blit_rop2_mirror(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source,
+                     const int x_source, const int y_source, enum blit_rop2 rop2) {
+  struct blit_rgn1 x_rgn1 = {
+      .origin = x,
+      .extent = x_extent,
+      .origin_source = x_source,
+  };
+  struct blit_rgn1 y_rgn1 = {
+      .origin = y,
+      .extent = y_extent,
+      .origin_source = y_source,
+  };
+  return blit_rgn1_rop2_mirror(result, &x_rgn1, &y_rgn1, source, rop2);
+}
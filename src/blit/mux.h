@@ -0,0 +1,46 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/mux.h
+ * \brief Raster operations as multiplexers.
+ * \details This private header file, shared by the binary and ternary
+ * operation kernels but not installed, declares the masks that evaluate any
+ * raster operation code with the same handful of word operations.
+ */
+
+#ifndef __BLIT_MUX_H__
+#define __BLIT_MUX_H__
+
+#include <blit/word.h>
+
+/*!
+ * \brief Multiplexer masks.
+ * \details Index j selects a pair of adjacent result bits in the operation
+ * code: the source bit for binary operations, `2P + S` for ternary ones. The
+ * destination selects between the pair: \c a holds the result for D = 0, and
+ * \c b the difference between the results for D = 1 and D = 0. The masks are
+ * all zeros or all ones, so truncating them to bytes loses nothing.
+ */
+struct blit_mux {
+  blit_word_t a[4];
+  blit_word_t b[4];
+};
+
+/*!
+ * \brief Starts the multiplexer masks for an operation code.
+ * \param mux Pointer to the masks.
+ * \param code The raster operation code.
+ * \param count Number of pairs: 2 for binary codes, 4 for ternary.
+ */
+static inline void blit_mux_start(struct blit_mux *mux, unsigned int code, int count) {
+  for (int j = 0; j < count; j++) {
+    const blit_word_t d0 = -(blit_word_t)((code >> (2 * j)) & 1U);
+    const blit_word_t d1 = -(blit_word_t)((code >> (2 * j + 1)) & 1U);
+    mux->a[j] = d0;
+    mux->b[j] = d0 ^ d1;
+  }
+}
+
+#endif /* __BLIT_MUX_H__ */
@@ -0,0 +1,192 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/pbm.c
+ * \brief Binary portable bitmap files.
+ * \details This source file implements the bitmap loading and storing
+ * declared in the `blit/pbm.h` header file.
+ */
+
+#include <blit/pbm.h>
+#include <blit/rgn1.h>
+#include <blit/word.h>
+
+#include <limits.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*!
+ * \brief Number of shifted bytes written per chunk.
+ */
+#define PBM_CHUNK 256
+
+static bool pbm_space(int c) { return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r'; }
+
+/*!
+ * \brief Parses a header number, after white space and comments.
+ * \param bytes The data.
+ * \param size Number of bytes.
+ * \param at Offset of the next byte, advanced past the number.
+ * \param number Receives the number.
+ * \retval true if there was a number in range.
+ */
+static bool pbm_number(const unsigned char *bytes, size_t size, size_t *at, int *number) {
+  for (;;) {
+    if (*at == size)
+      return false;
+    if (bytes[*at] == '#') {
+      while (*at < size && bytes[*at] != '\n' && bytes[*at] != '\r')
+        ++*at;
+    } else if (pbm_space(bytes[*at])) {
+      ++*at;
+    } else {
+      break;
+    }
+  }
+  if (bytes[*at] < '0' || bytes[*at] > '9')
+    return false;
+  long value = 0;
+  while (*at < size && bytes[*at] >= '0' && bytes[*at] <= '9') {
+    value = value * 10 + (bytes[(*at)++] - '0');
+    if (value > INT_MAX / 8)
+      return false;
+  }
+  *number = (int)value;
+  return true;
+}
+
+bool blit_pbm_parse(struct blit_scan *scan, const void *data, size_t size) {
+  const unsigned char *bytes = data;
+  size_t at = 2U;
+  int width, height;
+  if (size < 2U || bytes[0] != 'P' || bytes[1] != '4' || !pbm_number(bytes, size, &at, &width) || !pbm_number(bytes, size, &at, &height))
+    return false;
+  if (at == size || !pbm_space(bytes[at]))
+    return false;
+  at++;
+  const int stride = (width + 7) >> 3;
+  if ((size - at) / (stride > 0 ? (size_t)stride : 1U) < (size_t)height)
+    return false;
+  const struct blit_scan parsed = BLIT_SCAN_INIT((blit_scanline_t *)(bytes + at), width, height, stride);
+  *scan = parsed;
+  return true;
+}
+
+bool blit_pbm_map(struct blit_pbm_map *map, const char *path, bool writable) {
+  map->address = NULL;
+  map->size = 0U;
+#ifdef _WIN32
+  /*
+   * The view keeps the mapping alive after both handles close.
+   */
+  HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+  LARGE_INTEGER size;
+  HANDLE mapping = NULL;
+  if (GetFileSizeEx(file, &size) && size.QuadPart > 0 && (unsigned long long)size.QuadPart <= SIZE_MAX)
+    mapping = CreateFileMappingA(file, NULL, writable ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, NULL);
+  (void)CloseHandle(file);
+  if (mapping == NULL)
+    return false;
+  void *address = MapViewOfFile(mapping, writable ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+  (void)CloseHandle(mapping);
+  if (address == NULL)
+    return false;
+  map->address = address;
+  map->size = (size_t)size.QuadPart;
+#else
+  /*
+   * The mapping outlives the descriptor.
+   */
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  void *address = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && st.st_size > 0)
+    address = mmap(NULL, (size_t)st.st_size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
+  (void)close(fd);
+  if (address == MAP_FAILED)
+    return false;
+  map->address = address;
+  map->size = (size_t)st.st_size;
+#endif
+  if (!blit_pbm_parse(&map->scan, map->address, map->size)) {
+    blit_pbm_unmap(map);
+    return false;
+  }
+  return true;
+}
+
+void blit_pbm_unmap(struct blit_pbm_map *map) {
+  if (map->address == NULL)
+    return;
+#ifdef _WIN32
+  (void)UnmapViewOfFile(map->address);
+#else
+  (void)munmap(map->address, map->size);
+#endif
+  map->address = NULL;
+  map->size = 0U;
+}
+
+bool blit_pbm_write(FILE *file, const struct blit_scan *scan, int x, int y, int x_extent, int y_extent) {
+  struct blit_rgn1 x_rgn1 = {
+      .origin = x,
+      .extent = x_extent,
+      .origin_source = x,
+  };
+  struct blit_rgn1 y_rgn1 = {
+      .origin = y,
+      .extent = y_extent,
+      .origin_source = y,
+  };
+  blit_rgn1_norm(&x_rgn1);
+  blit_rgn1_norm(&y_rgn1);
+  if (!blit_rgn1_move(&x_rgn1) || !blit_rgn1_clip(&x_rgn1, scan->width - x_rgn1.origin) || !blit_rgn1_move(&y_rgn1) ||
+      !blit_rgn1_clip(&y_rgn1, scan->height - y_rgn1.origin))
+    x_rgn1.extent = y_rgn1.extent = 0;
+  if (fprintf(file, "P4\n%d %d\n", x_rgn1.extent, y_rgn1.extent) < 0)
+    return false;
+  if (x_rgn1.extent == 0 || y_rgn1.extent == 0)
+    return true;
+
+  /*
+   * The padding bits at the end of each row do not matter, so byte-aligned
+   * rows write as they stand. Others funnel shift, except that the last byte
+   * of a row must not read beyond the row's last source byte.
+   */
+  const int shift = x_rgn1.origin & 7, count = (x_rgn1.extent + 7) >> 3;
+  const int last = ((x_rgn1.origin + x_rgn1.extent - 1) >> 3) - (x_rgn1.origin >> 3);
+  blit_scanline_t chunk[PBM_CHUNK];
+  for (int v = y_rgn1.origin; v < y_rgn1.origin + y_rgn1.extent; v++) {
+    const blit_scanline_t *fetch = blit_scan_find(scan, x_rgn1.origin, v);
+    if (shift == 0) {
+      if (fwrite(fetch, 1U, (size_t)count, file) != (size_t)count)
+        return false;
+      continue;
+    }
+    for (int k0 = 0; k0 < count; k0 += PBM_CHUNK) {
+      const int chunk_count = count - k0 < PBM_CHUNK ? count - k0 : PBM_CHUNK;
+      int k = 0;
+      for (; k + BLIT_WORD_BYTES <= chunk_count && k0 + k + BLIT_WORD_BYTES <= last; k += BLIT_WORD_BYTES)
+        blit_word_store(chunk + k, blit_word_funnel(fetch + k0 + k, shift));
+      for (; k < chunk_count; k++)
+        chunk[k] = k0 + k < last ? blit_funnel(fetch + k0 + k, shift) : (blit_scanline_t)(fetch[k0 + k] << shift);
+      if (fwrite(chunk, 1U, (size_t)chunk_count, file) != (size_t)chunk_count)
+        return false;
+    }
+  }
+  return true;
+}
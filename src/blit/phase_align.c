@@ -84,6 +84,10 @@ blit_scanline_t blit_phase_align_fetch(struct blit_phase_align *align) {
   return (*align->fetch)(align);
 }
 
+enum blit_phase_align_mode blit_phase_align_mode(const struct blit_phase_align *align) {
+  return align->fetch == &fetch_left_shift ? blit_phase_align_left_shift : align->fetch == &fetch ? blit_phase_align_none : blit_phase_align_right_shift;
+}
+
 static void prefetch(struct blit_phase_align *align) { (void)align; }
 
 static void prefetch_left_shift(struct blit_phase_align *align) {
@@ -0,0 +1,209 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/pool.c
+ * \brief Worker pool for band-parallel blits.
+ * \details This source file implements the worker pool declared in the
+ * `blit/pool.h` header file, on POSIX threads or Win32 threads.
+ */
+
+#include <blit/pool.h>
+
+#include <stddef.h>
+
+/*!
+ * \brief Maximum number of worker threads.
+ */
+#define POOL_THREAD_MAX 64
+
+static int threshold = BLIT_POOL_THRESHOLD_DEFAULT;
+
+void blit_pool_set_threshold(int logic_count) { threshold = logic_count; }
+
+#ifdef BLIT_THREADS
+
+#ifdef _WIN32
+#include <process.h>
+#include <windows.h>
+typedef HANDLE pool_thread_t;
+#define POOL_LOCK() EnterCriticalSection(&pool.mutex)
+#define POOL_UNLOCK() LeaveCriticalSection(&pool.mutex)
+#define POOL_WAIT(cond) SleepConditionVariableCS(&pool.cond, &pool.mutex, INFINITE)
+#define POOL_BROADCAST(cond) WakeAllConditionVariable(&pool.cond)
+#else
+#include <pthread.h>
+typedef pthread_t pool_thread_t;
+#define POOL_LOCK() pthread_mutex_lock(&pool.mutex)
+#define POOL_UNLOCK() pthread_mutex_unlock(&pool.mutex)
+#define POOL_WAIT(cond) pthread_cond_wait(&pool.cond, &pool.mutex)
+#define POOL_BROADCAST(cond) pthread_cond_broadcast(&pool.cond)
+#endif
+
+/*!
+ * \brief Pool state.
+ * \details One mutex guards everything. Workers wait on \c wake for a new
+ * generation of jobs; the running thread waits on \c done for the last job
+ * to finish.
+ */
+static struct {
+#ifdef _WIN32
+  CRITICAL_SECTION mutex;
+  CONDITION_VARIABLE wake, done;
+#else
+  pthread_mutex_t mutex;
+  pthread_cond_t wake, done;
+#endif
+  pool_thread_t threads[POOL_THREAD_MAX];
+  int thread_count;
+  bool stopping;
+  bool busy;
+  unsigned int generation;
+  blit_pool_job_t job;
+  void *context;
+  int count;
+  int next;
+  int pending;
+} pool = {
+#ifndef _WIN32
+    .mutex = PTHREAD_MUTEX_INITIALIZER,
+    .wake = PTHREAD_COND_INITIALIZER,
+    .done = PTHREAD_COND_INITIALIZER,
+#endif
+    .thread_count = 0,
+};
+
+/*!
+ * \brief Takes and runs jobs until none remain.
+ * \details Call with the mutex locked; answers with it locked. The mutex is
+ * unlocked while each job runs.
+ */
+static void pool_work(void) {
+  while (pool.next < pool.count) {
+    const int index = pool.next++;
+    POOL_UNLOCK();
+    (*pool.job)(pool.context, index);
+    POOL_LOCK();
+    if (--pool.pending == 0)
+      POOL_BROADCAST(done);
+  }
+}
+
+#ifdef _WIN32
+static unsigned int __stdcall pool_worker(void *arg) {
+#else
+static void *pool_worker(void *arg) {
+#endif
+  (void)arg;
+  POOL_LOCK();
+  unsigned int generation = pool.generation;
+  for (;;) {
+    while (!pool.stopping && pool.generation == generation)
+      POOL_WAIT(wake);
+    if (pool.stopping)
+      break;
+    generation = pool.generation;
+    pool_work();
+  }
+  POOL_UNLOCK();
+  return 0;
+}
+
+static void pool_join(int thread_count) {
+  POOL_LOCK();
+  pool.stopping = true;
+  POOL_BROADCAST(wake);
+  POOL_UNLOCK();
+  for (int i = 0; i < thread_count; i++) {
+#ifdef _WIN32
+    (void)WaitForSingleObject(pool.threads[i], INFINITE);
+    (void)CloseHandle(pool.threads[i]);
+#else
+    (void)pthread_join(pool.threads[i], NULL);
+#endif
+  }
+  pool.stopping = false;
+#ifdef _WIN32
+  DeleteCriticalSection(&pool.mutex);
+#endif
+}
+
+bool blit_pool_start(int thread_count) {
+  if (pool.thread_count != 0 || thread_count <= 0 || thread_count > POOL_THREAD_MAX)
+    return false;
+#ifdef _WIN32
+  InitializeCriticalSection(&pool.mutex);
+  InitializeConditionVariable(&pool.wake);
+  InitializeConditionVariable(&pool.done);
+#endif
+  for (int i = 0; i < thread_count; i++) {
+#ifdef _WIN32
+    pool.threads[i] = (HANDLE)_beginthreadex(NULL, 0, &pool_worker, NULL, 0, NULL);
+    const bool started = pool.threads[i] != 0;
+#else
+    const bool started = pthread_create(pool.threads + i, NULL, &pool_worker, NULL) == 0;
+#endif
+    if (!started) {
+      pool_join(i);
+      return false;
+    }
+  }
+  pool.thread_count = thread_count;
+  return true;
+}
+
+void blit_pool_stop(void) {
+  if (pool.thread_count == 0)
+    return;
+  const int thread_count = pool.thread_count;
+  pool.thread_count = 0;
+  pool_join(thread_count);
+}
+
+int blit_pool_thread_count(void) { return pool.thread_count; }
+
+void blit_pool_run(blit_pool_job_t job, void *context, int count) {
+  if (pool.thread_count != 0) {
+    POOL_LOCK();
+    if (!pool.busy) {
+      pool.busy = true;
+      pool.job = job;
+      pool.context = context;
+      pool.count = count;
+      pool.next = 0;
+      pool.pending = count;
+      pool.generation++;
+      POOL_BROADCAST(wake);
+      pool_work();
+      while (pool.pending != 0)
+        POOL_WAIT(done);
+      pool.busy = false;
+      POOL_UNLOCK();
+      return;
+    }
+    POOL_UNLOCK();
+  }
+  for (int index = 0; index < count; index++)
+    (*job)(context, index);
+}
+
+#else
+
+bool blit_pool_start(int thread_count) {
+  (void)thread_count;
+  return false;
+}
+
+void blit_pool_stop(void) {}
+
+int blit_pool_thread_count(void) { return 0; }
+
+void blit_pool_run(blit_pool_job_t job, void *context, int count) {
+  for (int index = 0; index < count; index++)
+    (*job)(context, index);
+}
+
+#endif /* BLIT_THREADS */
+
+bool blit_pool_worthwhile(int logic_count) { return blit_pool_thread_count() != 0 && logic_count >= threshold; }
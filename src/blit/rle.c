@@ -0,0 +1,159 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/rle.c
+ * \brief Span-list compressed scans.
+ * \details This source file implements the compressed images declared in
+ * the `blit/rle.h` header file.
+ */
+
+#include <blit/damage.h>
+#include <blit/rle.h>
+#include <blit/rop1.h>
+#include <blit/word.h>
+
+#include "run.h"
+
+size_t blit_rle_encode(struct blit_rle *rle, const struct blit_scan *scan) {
+  if (scan->width > UINT16_MAX) {
+    rle->width = rle->height = 0;
+    rle->row[0] = 0U;
+    return 0U;
+  }
+  rle->width = scan->width;
+  rle->height = scan->height;
+  const int byte_count = (scan->width + 7) >> 3;
+  size_t count = 0U;
+  for (int v = 0; v < scan->height; v++) {
+    rle->row[v] = (uint32_t)count;
+    const blit_scanline_t *fetch = blit_scan_find(scan, 0, v);
+    bool ink = false;
+    int start = 0;
+    for (int k = 0; k < byte_count; k++) {
+      /*
+       * Skip whole words, then whole bytes, that continue the current run.
+       * Look at bits only where the run might end, and never past the width.
+       */
+      const blit_scanline_t run = ink ? 0xffU : 0x00U;
+      while (k + BLIT_WORD_BYTES <= byte_count && blit_word_load(fetch + k) == blit_word_splat(run))
+        k += BLIT_WORD_BYTES;
+      if (k == byte_count)
+        break;
+      if (fetch[k] == run)
+        continue;
+      for (int x = k << 3; x < (k << 3) + 8 && x < scan->width; x++) {
+        if (((fetch[k] >> (7 - (x & 7))) & 1) == (ink ? 1 : 0))
+          continue;
+        if (ink) {
+          if (count < rle->span_max) {
+            rle->span[2 * count] = (uint16_t)start;
+            rle->span[2 * count + 1] = (uint16_t)x;
+          }
+          count++;
+        } else {
+          start = x;
+        }
+        ink = !ink;
+      }
+    }
+    if (ink) {
+      if (count < rle->span_max) {
+        rle->span[2 * count] = (uint16_t)start;
+        rle->span[2 * count + 1] = (uint16_t)scan->width;
+      }
+      count++;
+    }
+  }
+  rle->row[scan->height] = (uint32_t)count;
+
+  /*
+   * Row indices past the span storage would send decoding and blitting out
+   * of bounds. An incomplete encoding is no encoding.
+   */
+  if (count > rle->span_max) {
+    rle->width = rle->height = 0;
+    rle->row[0] = 0U;
+  }
+  return count;
+}
+
+void blit_rle_decode(const struct blit_rle *rle, struct blit_scan *scan) {
+  if (rle->width <= 0)
+    return;
+  for (int v = 0; v < rle->height; v++) {
+    blit_scanline_t *store = blit_scan_find(scan, 0, v);
+    (void)blit_run_rop1(store, 0, rle->width, blit_rop1_0);
+    for (uint32_t i = rle->row[v]; i < rle->row[v + 1]; i++)
+      (void)blit_run_rop1(store, rle->span[2 * i], rle->span[2 * i + 1], blit_rop1_1);
+  }
+}
+
+int blit_rgn1_rop2_rle(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_rle *source, enum blit_rop2 rop2) {
+  blit_rgn1_norm(x);
+  if (!blit_rgn1_move(x) || !blit_rgn1_clip(x, result->width - x->origin) || !blit_rgn1_clip(x, source->width - x->origin_source))
+    return 0;
+  blit_rgn1_norm(y);
+  if (!blit_rgn1_move(y) || !blit_rgn1_clip(y, result->height - y->origin) || !blit_rgn1_clip(y, source->height - y->origin_source))
+    return 0;
+
+  /*
+   * Set source pixels select the upper pair of the code's bits, clear source
+   * pixels the lower pair; each pair is a unary code.
+   */
+  const enum blit_rop1 ink = (enum blit_rop1)(rop2 >> 2), paper = (enum blit_rop1)(rop2 & 3);
+  if (ink == paper) {
+    struct blit_rgn1 x_rop1 = *x, y_rop1 = *y;
+    return blit_rgn1_rop1(result, &x_rop1, &y_rop1, ink);
+  }
+  blit_scan_damage(result, x, y);
+
+  const int first = x->origin_source, last = x->origin_source + x->extent, offset = x->origin - x->origin_source;
+  int logic_count = 0;
+  for (int v = 0; v < y->extent; v++) {
+    blit_scanline_t *store = blit_scan_find(result, 0, y->origin + v);
+    const uint32_t row = source->row[y->origin_source + v], row_end = source->row[y->origin_source + v + 1];
+
+    /*
+     * Binary search for the first span ending inside the region, then walk
+     * spans and the gaps between them up to the region's end.
+     */
+    uint32_t i = row, j = row_end;
+    while (i < j) {
+      const uint32_t k = i + (j - i) / 2;
+      if (source->span[2 * k + 1] <= first)
+        i = k + 1;
+      else
+        j = k;
+    }
+    int cursor = first;
+    for (; i < row_end && source->span[2 * i] < last; i++) {
+      const int x0 = source->span[2 * i] > cursor ? source->span[2 * i] : cursor;
+      const int x1 = source->span[2 * i + 1] < last ? source->span[2 * i + 1] : last;
+      if (x0 > cursor && paper != blit_rop1_D)
+        logic_count += blit_run_rop1(store, cursor + offset, x0 + offset, paper);
+      if (ink != blit_rop1_D)
+        logic_count += blit_run_rop1(store, x0 + offset, x1 + offset, ink);
+      cursor = x1;
+    }
+    if (cursor < last && paper != blit_rop1_D)
+      logic_count += blit_run_rop1(store, cursor + offset, last + offset, paper);
+  }
+  return logic_count;
+}
+
+int blit_rop2_rle(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_rle *source,
+                  const int x_source, const int y_source, enum blit_rop2 rop2) {
+  struct blit_rgn1 x_rgn1 = {
+      .origin = x,
+      .extent = x_extent,
+      .origin_source = x_source,
+  };
+  struct blit_rgn1 y_rgn1 = {
+      .origin = y,
+      .extent = y_extent,
+      .origin_source = y_source,
+  };
+  return blit_rgn1_rop2_rle(result, &x_rgn1, &y_rgn1, source, rop2);
+}
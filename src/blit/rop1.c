@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/rop1.c
+ * \brief Unary raster operations.
+ * \details This source file implements the functions for performing unary
+ * raster operations on scan structures, as declared in the `blit/rop1.h`
+ * header file.
+ */
+
+#include <blit/damage.h>
+#include <blit/rop1.h>
+#include <blit/span.h>
+
+#include <string.h>
+
+#include "run.h"
+
+int blit_run_rop1(blit_scanline_t *store, int x0, int x1, enum blit_rop1 rop1) {
+  /*
+   * Each byte of the run becomes (D & keep) ^ flip, under the mask: clearing
+   * keeps nothing and flips nothing, setting keeps nothing and flips
+   * everything, inverting keeps everything and flips everything.
+   */
+  const int x_max = x1 - 1;
+  const int extra_scan_count = (x_max >> 3) - (x0 >> 3);
+  blit_scanline_t scan_origin_mask = 0xffU >> (x0 & 7);
+  blit_scanline_t scan_extent_mask = 0xffU << (7 - (x_max & 7));
+  if (extra_scan_count == 0)
+    scan_origin_mask = scan_extent_mask = scan_origin_mask & scan_extent_mask;
+  const blit_scanline_t keep = rop1 == blit_rop1_Dn ? 0xffU : 0x00U;
+  const blit_scanline_t flip = rop1 == blit_rop1_0 ? 0x00U : 0xffU;
+  store += x0 >> 3;
+  store[0] = (store[0] & ~scan_origin_mask) | (((store[0] & keep) ^ flip) & scan_origin_mask);
+  if (extra_scan_count == 0)
+    return 1;
+  if (extra_scan_count > 1) {
+    /*
+     * The inverting span kernel ignores its source operand; hand it the
+     * destination so that it fetches nothing it should not.
+     */
+    if (rop1 == blit_rop1_Dn)
+      (*blit_span_func(blit_rop2_Dn))(store + 1, store + 1, 0, extra_scan_count - 1);
+    else
+      (void)memset(store + 1, flip, (size_t)(extra_scan_count - 1));
+  }
+  store[extra_scan_count] = (store[extra_scan_count] & ~scan_extent_mask) | (((store[extra_scan_count] & keep) ^ flip) & scan_extent_mask);
+  return extra_scan_count + 1;
+}
+
+int blit_rgn1_rop1(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, enum blit_rop1 rop1) {
+  /*
+   * Normalise, move, and clip the regions against the destination. The source
+   * origins follow the origins so that moving into positive space depends on
+   * the destination alone.
+   */
+  x->origin_source = x->origin;
+  blit_rgn1_norm(x);
+  if (!blit_rgn1_move(x) || !blit_rgn1_clip(x, result->width - x->origin))
+    return 0;
+  y->origin_source = y->origin;
+  blit_rgn1_norm(y);
+  if (!blit_rgn1_move(y) || !blit_rgn1_clip(y, result->height - y->origin))
+    return 0;
+
+  const int x_max = x->origin + x->extent - 1;
+  const int extra_scan_count = (x_max >> 3) - (x->origin >> 3);
+  const int logic_count = y->extent * (extra_scan_count + 1);
+  if (rop1 == blit_rop1_D)
+    return logic_count;
+  blit_scan_damage(result, x, y);
+
+  blit_scanline_t *store = blit_scan_find(result, 0, y->origin);
+  for (int extent = y->extent; extent--; store += result->stride)
+    (void)blit_run_rop1(store, x->origin, x->origin + x->extent, rop1);
+  return logic_count;
+}
+
+int blit_rop1(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, enum blit_rop1 rop1) {
+  struct blit_rgn1 x_rgn1 = {
+      .origin = x,
+      .extent = x_extent,
+      .origin_source = x,
+  };
+  struct blit_rgn1 y_rgn1 = {
+      .origin = y,
+      .extent = y_extent,
+      .origin_source = y,
+  };
+  return blit_rgn1_rop1(result, &x_rgn1, &y_rgn1, rop1);
+}
@@ -9,11 +9,20 @@
  * raster operations on scan structures, as declared in the `blit/rop2.h` header
  * file. These operations combine source and destination pixel values using
  * bitwise operations. The implementation includes functions for various raster
- * operations, such as copy, invert, and, or, xor, and others.
+ * operations, such as copy, invert, and, or, xor, and others, on single scans
+ * and on multi-plane scans.
  */
 
+#include <blit/damage.h>
 #include <blit/phase_align.h>
+#include <blit/planar.h>
+#include <blit/pool.h>
+#include <blit/rop1.h>
 #include <blit/rop2.h>
+#include <blit/span.h>
+#include <blit/stats.h>
+
+#include <stdlib.h>
 
 /*!
  * \brief 8-bit source operand.
@@ -26,13 +35,195 @@
 #define D (store)
 
 /*!
- * \brief Type definition for raster operation function pointer.
- * \details This type defines a function pointer for raster operation functions.
- * Each raster operation function takes two 8-bit operands: the source operand
- * (`fetch`) and the destination operand (`store`). The function returns an
- * 8-bit result of the raster operation.
+ * \brief Bit block transfer loop parameters.
+ * \details Everything a transfer loop needs, worked out once per call after
+ * clipping so that the loops themselves do no more than walk the scanlines.
  */
-typedef blit_scanline_t (*blit_rop2_func_t)(blit_scanline_t fetch, blit_scanline_t store);
+struct rop2_loop {
+  /*!
+   * \brief First destination byte of the first scanline.
+   */
+  blit_scanline_t *store;
+  /*!
+   * \brief First source byte of the first scanline.
+   */
+  const blit_scanline_t *fetch;
+  /*!
+   * \brief Phase shift in bits, 1 through 7, or 0 for no shift.
+   */
+  int shift;
+  /*!
+   * \brief Number of destination bytes beyond the first in each scanline.
+   */
+  int extra_scan_count;
+  /*!
+   * \brief Number of source bytes holding source bits in each scanline.
+   * \details The last destination byte of a shifted scanline may need its
+   * low bits from a further source byte, or it may not. Fetching only what
+   * the source really spans keeps the loops from reading beyond the end of
+   * the source buffer.
+   */
+  int fetch_count;
+  /*!
+   * \brief Mask for the first byte of each scanline.
+   */
+  blit_scanline_t origin_mask;
+  /*!
+   * \brief Mask for the last byte of each scanline.
+   */
+  blit_scanline_t extent_mask;
+  /*!
+   * \brief Process each scanline from right to left.
+   */
+  bool reverse;
+  /*!
+   * \brief Destination stride in bytes, negative when working bottom up.
+   */
+  int stride;
+  /*!
+   * \brief Source stride in bytes, negative when working bottom up.
+   */
+  int stride_source;
+  /*!
+   * \brief Number of scanlines.
+   */
+  int extent;
+  /*!
+   * \brief Span kernel for the unmasked middle of each scanline.
+   */
+  blit_span_func_t span;
+};
+
+/*!
+ * \brief Type definition for a bit block transfer loop function pointer.
+ */
+typedef void (*rop2_loop_func_t)(const struct rop2_loop *loop);
+
+/*!
+ * \brief Band of scanlines for a worker pool job.
+ * \details Job \e i runs the loop over scanlines `i * extent` onwards, at
+ * most \c extent of them.
+ */
+struct rop2_band {
+  rop2_loop_func_t func;
+  const struct rop2_loop *loop;
+  int extent;
+};
+
+static void rop2_band_job(void *context, int index) {
+  const struct rop2_band *band = context;
+  struct rop2_loop loop = *band->loop;
+  const int origin = index * band->extent;
+  loop.store += origin * loop.stride;
+  loop.fetch += origin * loop.stride_source;
+  loop.extent = band->extent < loop.extent - origin ? band->extent : loop.extent - origin;
+  (*band->func)(&loop);
+}
+
+/*!
+ * \brief Bands per pool thread.
+ * \details More bands than threads lets quicker threads take up the slack.
+ */
+#define ROP2_BANDS_PER_THREAD 4
+
+/*!
+ * \brief Spans shorter than this many bytes run inline rather than through
+ * the span kernel.
+ * \details Narrow transfers, glyphs and small icons, would otherwise spend
+ * more on the call than on the bytes.
+ */
+#define ROP2_LOOP_SPAN_MIN 8
+
+/*
+ * Phase fetches. Each expands to byte k of the phase-aligned source stream for
+ * a scanline whose first source byte is at fetch. A left shift draws each byte
+ * from source bytes k and k + 1; a right shift from bytes k - 1 and k, with
+ * nothing before the first. The _LAST variants fetch the final byte of a
+ * scanline and leave out the further source byte when the source does not
+ * span it.
+ */
+#define FETCH_left_shift(k) ((blit_scanline_t)((fetch[k] << shift) | (fetch[(k) + 1] >> (8 - shift))))
+#define FETCH_LAST_left_shift(k) \
+  ((blit_scanline_t)((fetch[k] << shift) | ((k) + 1 < loop->fetch_count ? fetch[(k) + 1] >> (8 - shift) : 0)))
+#define FETCH_none(k) (fetch[k])
+#define FETCH_LAST_none(k) (fetch[k])
+#define FETCH_right_shift(k) ((blit_scanline_t)((k) == 0 ? fetch[0] >> shift : (fetch[(k) - 1] << (8 - shift)) | (fetch[k] >> shift)))
+#define FETCH_LAST_right_shift(k)                 \
+  ((blit_scanline_t)((k) == 0 ? fetch[0] >> shift \
+                              : (fetch[(k) - 1] << (8 - shift)) | ((k) < loop->fetch_count ? fetch[k] >> shift : 0)))
+
+/*
+ * Span fetches: the pointer and left funnel shift that hand the middle of a
+ * scanline, from byte 1, to a span kernel.
+ */
+#define SPAN_left_shift fetch + 1, shift
+#define SPAN_none fetch + 1, 0
+#define SPAN_right_shift fetch, 8 - shift
+
+/*!
+ * \brief Macro to define a bit block transfer loop.
+ * \details Defines the loop for one raster operation in one phase mode. Both
+ * are fixed at compile time, so the raster operation function and the fetch
+ * expand inline; nothing calls through a pointer per byte. The middle of each
+ * scanline goes to the span kernel, one call per scanline, unless it is
+ * shorter than `ROP2_LOOP_SPAN_MIN` bytes.
+ *
+ * A reversed loop visits the same bytes last to first: extent byte, middle,
+ * origin byte. Each fetch indexes the source directly, so the fetches need no
+ * reversing; only their order changes.
+ * \param rop The raster operation function, \c rop followed by the reverse
+ * polish notation name. Pasting the name before it reaches this macro stops
+ * names such as \c D and \c S expanding as operands.
+ * \param phase The phase mode: left_shift, none or right_shift.
+ */
+#define ROP2_LOOP(rop, phase)                                                                                         \
+  static void rop##_##phase(const struct rop2_loop *loop);                                                            \
+  void rop##_##phase(const struct rop2_loop *loop) {                                                                  \
+    blit_scanline_t *store = loop->store;                                                                             \
+    const blit_scanline_t *fetch = loop->fetch;                                                                       \
+    const int shift = loop->shift;                                                                                    \
+    const int extra = loop->extra_scan_count;                                                                         \
+    int extent = loop->extent;                                                                                        \
+    (void)shift;                                                                                                      \
+    if (extra == 0) {                                                                                                 \
+      const blit_scanline_t mask = loop->origin_mask & loop->extent_mask;                                             \
+      while (extent--) {                                                                                              \
+        *store = (*store & ~mask) | (mask & rop(FETCH_LAST_##phase(0), *store));                                      \
+        store += loop->stride;                                                                                        \
+        fetch += loop->stride_source;                                                                                 \
+      }                                                                                                               \
+      return;                                                                                                         \
+    }                                                                                                                 \
+    if (loop->reverse) {                                                                                              \
+      while (extent--) {                                                                                              \
+        store[extra] =                                                                                                \
+            (store[extra] & ~loop->extent_mask) | (loop->extent_mask & rop(FETCH_LAST_##phase(extra), store[extra])); \
+        if (extra - 1 < ROP2_LOOP_SPAN_MIN) {                                                                         \
+          for (int k = extra - 1; k > 0; k--)                                                                         \
+            store[k] = rop(FETCH_##phase(k), store[k]);                                                               \
+        } else {                                                                                                      \
+          (*loop->span)(store + 1, SPAN_##phase, extra - 1);                                                          \
+        }                                                                                                             \
+        *store = (*store & ~loop->origin_mask) | (loop->origin_mask & rop(FETCH_##phase(0), *store));                 \
+        store += loop->stride;                                                                                        \
+        fetch += loop->stride_source;                                                                                 \
+      }                                                                                                               \
+      return;                                                                                                         \
+    }                                                                                                                 \
+    while (extent--) {                                                                                                \
+      *store = (*store & ~loop->origin_mask) | (loop->origin_mask & rop(FETCH_##phase(0), *store));                   \
+      if (extra - 1 < ROP2_LOOP_SPAN_MIN) {                                                                           \
+        for (int k = 1; k < extra; k++)                                                                               \
+          store[k] = rop(FETCH_##phase(k), store[k]);                                                                 \
+      } else {                                                                                                        \
+        (*loop->span)(store + 1, SPAN_##phase, extra - 1);                                                            \
+      }                                                                                                               \
+      store[extra] =                                                                                                  \
+          (store[extra] & ~loop->extent_mask) | (loop->extent_mask & rop(FETCH_LAST_##phase(extra), store[extra]));   \
+      store += loop->stride;                                                                                          \
+      fetch += loop->stride_source;                                                                                   \
+    }                                                                                                                 \
+  }
 
 /*!
  * \brief Macro to define a raster operation function.
@@ -61,13 +252,18 @@ typedef blit_scanline_t (*blit_rop2_func_t)(blit_scanline_t fetch, blit_scanline
  * - 1: Always returns 1 (0xffU).
  *
  * Each operation is implemented as a static function returning the result of
- * the specified bitwise expression.
+ * the specified bitwise expression, followed by its three bit block transfer
+ * loops, one for each phase mode. The span kernels in `blit/span.c` repeat
+ * the same expressions for whole words and vectors.
  * \param revPolish The reverse polish notation name of the raster operation.
  * \param x The expression defining the raster operation using D and S.
  */
-#define ROP_REV_POLISH(revPolish, x)                                                   \
-  static blit_scanline_t rop##revPolish(blit_scanline_t fetch, blit_scanline_t store); \
-  blit_scanline_t rop##revPolish(blit_scanline_t fetch, blit_scanline_t store) { return x; }
+#define ROP_REV_POLISH(revPolish, x)                                                         \
+  static blit_scanline_t rop##revPolish(blit_scanline_t fetch, blit_scanline_t store);       \
+  blit_scanline_t rop##revPolish(blit_scanline_t fetch, blit_scanline_t store) { return x; } \
+  ROP2_LOOP(rop##revPolish, left_shift)                                                      \
+  ROP2_LOOP(rop##revPolish, none)                                                            \
+  ROP2_LOOP(rop##revPolish, right_shift)
 
 /*!
  * \brief Raster operation: 0.
@@ -157,78 +353,119 @@ ROP_REV_POLISH(DSo, D | S);
 ROP_REV_POLISH(1, 0xffU);
 
 /*!
- * \brief Array of raster operation functions.
- * \details This array maps raster operation codes to their corresponding
- * functions. Each function implements a specific raster operation defined
- * using bitwise operations on the source (S) and destination (D) operands.
- */
-static blit_rop2_func_t rop2_func[] = {&rop0,   &ropDSon, &ropDSna, &ropSn,   &ropSDna, &ropDn,   &ropDSx, &ropDSan,
-                                       &ropDSa, &ropDSxn, &ropD,    &ropDSno, &ropS,    &ropSDno, &ropDSo, &rop1};
-
-/*!
- * \brief Perform raster operation with masking and store the result.
- * \param align Pointer to the phase alignment structure.
- * \param rop2 The raster operation code.
- * \param mask The mask to apply to the operation.
- * \param store Pointer to the destination operand.
+ * \brief Array of bit block transfer loops.
+ * \details This array maps raster operation codes and phase modes to their
+ * corresponding loops. Each loop implements a specific raster operation
+ * defined using bitwise operations on the source (S) and destination (D)
+ * operands, fetching the source in one specific phase mode.
  */
-static void fetch_logic_mask_store(struct blit_phase_align *align, enum blit_rop2 rop2, blit_scanline_t mask, blit_scanline_t *store);
+static const rop2_loop_func_t rop2_loop_func[][3] = {
+    {&rop0_left_shift, &rop0_none, &rop0_right_shift},          {&ropDSon_left_shift, &ropDSon_none, &ropDSon_right_shift},
+    {&ropDSna_left_shift, &ropDSna_none, &ropDSna_right_shift}, {&ropSn_left_shift, &ropSn_none, &ropSn_right_shift},
+    {&ropSDna_left_shift, &ropSDna_none, &ropSDna_right_shift}, {&ropDn_left_shift, &ropDn_none, &ropDn_right_shift},
+    {&ropDSx_left_shift, &ropDSx_none, &ropDSx_right_shift},    {&ropDSan_left_shift, &ropDSan_none, &ropDSan_right_shift},
+    {&ropDSa_left_shift, &ropDSa_none, &ropDSa_right_shift},    {&ropDSxn_left_shift, &ropDSxn_none, &ropDSxn_right_shift},
+    {&ropD_left_shift, &ropD_none, &ropD_right_shift},          {&ropDSno_left_shift, &ropDSno_none, &ropDSno_right_shift},
+    {&ropS_left_shift, &ropS_none, &ropS_right_shift},          {&ropSDno_left_shift, &ropSDno_none, &ropSDno_right_shift},
+    {&ropDSo_left_shift, &ropDSo_none, &ropDSo_right_shift},    {&rop1_left_shift, &rop1_none, &rop1_right_shift},
+};
 
 /*!
- * \brief Perform raster operation and store the result.
- * \param align Pointer to the phase alignment structure.
- * \param rop2 The raster operation code.
- * \param store Pointer to the destination operand.
+ * \brief Normalises, moves and clips the regions against destination and
+ * source dimensions.
+ * \details The regions are first normalised to ensure that their extents are
+ * non-negative. Then, they are moved to ensure that their origins are
+ * non-negative. Finally, they are clipped to ensure that they fit within the
+ * bounds of the destination and source scan structures.
+ * \retval true if anything remains to transfer.
+ * \retval false if the regions moved or clipped to nothing.
  */
-static void fetch_logic_store(struct blit_phase_align *align, enum blit_rop2 rop2, blit_scanline_t *store);
-
-int blit_rgn1_rop2(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, enum blit_rop2 rop2) {
-  /*
-   * Normalise, move, and clip the x region. The regions are first normalised to
-   * ensure that their extents are non-negative. Then, they are moved to
-   * ensure that their origins are non-negative. Finally, they are clipped to
-   * ensure that they fit within the bounds of the destination and source scan
-   * structures.
-   */
+static bool rop2_clip(struct blit_rgn1 *x, struct blit_rgn1 *y, int width, int height, int width_source, int height_source) {
   blit_rgn1_norm(x);
-  if (!blit_rgn1_move(x) || !blit_rgn1_clip(x, result->width - x->origin) || !blit_rgn1_clip(x, source->width - x->origin_source))
-    return 0;
+  if (!blit_rgn1_move(x)) {
+    BLIT_STATS_COUNT(blit_stats_rejected_move, 1);
+    return false;
+  }
+  if (!blit_rgn1_clip(x, width - x->origin) || !blit_rgn1_clip(x, width_source - x->origin_source)) {
+    BLIT_STATS_COUNT(blit_stats_rejected_clip, 1);
+    return false;
+  }
 
   /*
    * Normalise, move, and clip the y region.
    */
   blit_rgn1_norm(y);
-  if (!blit_rgn1_move(y) || !blit_rgn1_clip(y, result->height - y->origin) || !blit_rgn1_clip(y, source->height - y->origin_source))
-    return 0;
+  if (!blit_rgn1_move(y)) {
+    BLIT_STATS_COUNT(blit_stats_rejected_move, 1);
+    return false;
+  }
+  if (!blit_rgn1_clip(y, height - y->origin) || !blit_rgn1_clip(y, height_source - y->origin_source)) {
+    BLIT_STATS_COUNT(blit_stats_rejected_clip, 1);
+    return false;
+  }
+  return true;
+}
 
+/*!
+ * \brief Sets up the transfer loop parameters for clipped regions.
+ * \details Everything except the span kernel, which depends on the raster
+ * operation.
+ * \return The phase mode, which selects the loop.
+ */
+static enum blit_phase_align_mode rop2_loop_start(struct rop2_loop *loop, const struct blit_rgn1 *x, const struct blit_rgn1 *y, const struct blit_scan *result,
+                                                  const struct blit_scan *source) {
   /*
    * Compute some important values up front to avoid doing it inside the bit
    * block transfer loops. The x_max constant represents the maximum x
-   * coordinate of the region to be processed. The extra_scan_count constant
+   * coordinate of the region to be processed. The extra_scan_count member
    * calculates how many additional bytes (beyond the first byte) are needed to
-   * cover the width of the region in bytes. The scan_origin_mask and
-   * scan_extent_mask constants are used to mask the bits at the start and end
-   * of each scanline, ensuring that only the relevant bits are processed. The
-   * offset and offset_source constants are used to calculate the stride offsets
-   * for the destination and source scanlines, respectively, allowing for
-   * efficient traversal of the scanline buffers.
+   * cover the width of the region in bytes. The origin and extent masks are
+   * used to mask the bits at the start and end of each scanline, ensuring that
+   * only the relevant bits are processed. The strides allow for efficient
+   * traversal of the scanline buffers.
    */
   const int x_max = x->origin + x->extent - 1;
-  const int extra_scan_count = (x_max >> 3) - (x->origin >> 3);
-  const blit_scanline_t scan_origin_mask = 0xffU >> (x->origin & 7);
-  const blit_scanline_t scan_extent_mask = 0xffU << (7 - (x_max & 7));
-  const int offset = result->stride - 1 - extra_scan_count;
-  const int offset_source = source->stride - 1 - extra_scan_count;
-  blit_scanline_t *store = blit_scan_find(result, x->origin, y->origin);
+  int y_store = y->origin, y_fetch = y->origin_source, stride = result->stride, stride_source = source->stride;
+  bool reverse = false;
+
+  /*
+   * Overlap. When destination and source share storage and the regions
+   * overlap, the order of the scanlines and of the bytes within them decides
+   * whether a store overwrites source bits before they are fetched. Work bottom
+   * up when moving down; work right to left when moving right along the same
+   * scanlines. Otherwise, the usual top-down, left-to-right order is safe.
+   * This gives memmove-like semantics without copying through a temporary.
+   */
+  if (result->store == source->store && abs(y->origin - y->origin_source) < y->extent && abs(x->origin - x->origin_source) < x->extent) {
+    if (y->origin > y->origin_source) {
+      y_store += y->extent - 1;
+      y_fetch += y->extent - 1;
+      stride = -stride;
+      stride_source = -stride_source;
+    } else if (y->origin == y->origin_source && x->origin > x->origin_source) {
+      reverse = true;
+    }
+  }
+
+  *loop = (struct rop2_loop){
+      .store = blit_scan_find(result, x->origin, y_store),
+      .extra_scan_count = (x_max >> 3) - (x->origin >> 3),
+      .fetch_count = (((x->origin_source & 7) + x->extent - 1) >> 3) + 1,
+      .origin_mask = 0xffU >> (x->origin & 7),
+      .extent_mask = 0xffU << (7 - (x_max & 7)),
+      .reverse = reverse,
+      .stride = stride,
+      .stride_source = stride_source,
+      .extent = y->extent,
+  };
 
   /*
    * Set up phase alignment for source fetches. The source x position is given
    * by x->origin_source. The destination x position is given by x->origin. The
    * shift is the difference between these two positions modulo 8. The phase
-   * alignment structure handles the bit shifts required to align the source
-   * data with the destination data based on the bit positions. Each fetch from
-   * the phase alignment structure returns a byte (8 bits) aligned according to
-   * the specified bit positions.
+   * alignment structure works out the bit shifts required to align the source
+   * data with the destination data based on the bit positions, and which of
+   * the three phase modes applies.
    *
    * The & 7 operation here ensures that we are working within the bounds of a
    * byte (0-7 bits). This is important because the phase alignment also
@@ -238,12 +475,84 @@ int blit_rgn1_rop2(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rg
    * get out of sync! Keep them in step!
    */
   struct blit_phase_align align;
-  blit_phase_align_start(&align, x->origin, x->origin_source & 7, blit_scan_find(source, x->origin_source, y->origin_source));
+  blit_phase_align_start(&align, x->origin, x->origin_source & 7, blit_scan_find(source, x->origin_source, y_fetch));
+  loop->fetch = align.store;
+  loop->shift = align.shift;
+  const enum blit_phase_align_mode mode = blit_phase_align_mode(&align);
+  BLIT_STATS_COUNT(blit_stats_phase_left_shift + mode, 1);
+  return mode;
+}
+
+/*!
+ * \brief Runs a transfer loop.
+ * \details Large transfers run in bands of scanlines on the worker pool, if
+ * started. Bands write disjoint scanlines, so they need no ordering among
+ * themselves unless the destination and source share storage, in which case
+ * one band might read what another writes. Such transfers stay serial.
+ * \param func The transfer loop.
+ * \param loop Pointer to the loop parameters.
+ * \param shared True if destination and source share storage.
+ * \return The number of logic operations performed.
+ */
+static int rop2_loop_run(rop2_loop_func_t func, const struct rop2_loop *loop, bool shared) {
+  const int logic_count = loop->extent * (loop->extra_scan_count + 1);
+  BLIT_STATS_COUNT(blit_stats_rows, loop->extent);
+  BLIT_STATS_COUNT(blit_stats_edge_stores, loop->extent * (loop->extra_scan_count == 0 ? 1 : 2));
+  BLIT_STATS_COUNT(blit_stats_interior_stores, loop->extent * (loop->extra_scan_count == 0 ? 0 : loop->extra_scan_count - 1));
+  if (loop->extent > 1 && blit_pool_worthwhile(logic_count) && !shared) {
+    int band_count = (blit_pool_thread_count() + 1) * ROP2_BANDS_PER_THREAD;
+    if (band_count > loop->extent)
+      band_count = loop->extent;
+    struct rop2_band band = {
+        .func = func,
+        .loop = loop,
+        .extent = (loop->extent + band_count - 1) / band_count,
+    };
+    blit_pool_run(&rop2_band_job, &band, (loop->extent + band.extent - 1) / band.extent);
+    BLIT_STATS_COUNT(blit_stats_parallel, 1);
+  } else {
+    (*func)(loop);
+  }
+  return logic_count;
+}
+
+/*!
+ * \brief Tests whether two byte ranges overlap.
+ */
+static bool rop2_shared(const blit_scanline_t *store, int size, const blit_scanline_t *store_source, int size_source) {
+  return store < store_source + size_source && store_source < store + size;
+}
+
+int blit_rgn1_rop2(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, enum blit_rop2 rop2) {
+  BLIT_STATS_CLOCK(start);
+  BLIT_STATS_COUNT(blit_stats_calls, 1);
+  if (!rop2_clip(x, y, result->width, result->height, source->width, source->height))
+    return 0;
+
+  /*
+   * Source-free raster operations. A code whose upper pair of bits, for source
+   * bit 1, matches its lower pair, for source bit 0, ignores the source. Hand
+   * it to the unary operations, which neither fetch nor phase align. The
+   * regions stay clipped against the source as well, as before; the copies
+   * leave the caller's source origins alone.
+   */
+  if ((rop2 >> 2) == (rop2 & 3)) {
+    struct blit_rgn1 x_rop1 = *x, y_rop1 = *y;
+    const int logic_count = blit_rgn1_rop1(result, &x_rop1, &y_rop1, (enum blit_rop1)(rop2 & 3));
+    BLIT_STATS_COUNT(blit_stats_source_free, 1);
+    BLIT_STATS_ELAPSED(start);
+    return logic_count;
+  }
+
+  /*
+   * Record the clipped destination as damaged, if the scan tracks damage.
+   */
+  blit_scan_damage(result, x, y);
 
   /*
    * Perform the bit block transfer using the specified raster operation. The
    * transfer is done scanline by scanline, processing each byte in the scanline
-   * according to the raster operation defined by rop2. The function handles the
+   * according to the raster operation defined by rop2. The loop handles the
    * masking of the first and last bytes in each scanline to ensure that only
    * the relevant bits are modified. If there are no extra bytes beyond the
    * first byte, it processes the scanline in a single pass. If there are extra
@@ -251,37 +560,60 @@ int blit_rgn1_rop2(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rg
    * middle bytes without masking, and finally processes the last byte with the
    * extent mask.
    *
-   * This approach ensures that the bit block transfer is efficient and
-   * correctly applies the raster operation across the specified region. The use
-   * of the phase alignment structure ensures that the source data is correctly
-   * aligned with the destination data during the transfer.
+   * Choose the loop once, by raster operation and phase mode. Inside it,
+   * neither the operation nor the fetch goes through a function pointer.
    */
-  int extent = y->extent, logic_count = 0;
-  if (extra_scan_count == 0) {
-    const blit_scanline_t scan_mask = scan_origin_mask & scan_extent_mask;
-    while (extent--) {
-      blit_phase_align_prefetch(&align);
-      fetch_logic_mask_store(&align, rop2, scan_mask, store++);
-      logic_count++;
-      store += offset;
-      align.store += offset_source;
-    }
-  } else {
-    while (extent--) {
-      blit_phase_align_prefetch(&align);
-      fetch_logic_mask_store(&align, rop2, scan_origin_mask, store++);
-      logic_count++;
-      int extra = extra_scan_count;
-      while (--extra) {
-        fetch_logic_store(&align, rop2, store++);
-        logic_count++;
-      }
-      fetch_logic_mask_store(&align, rop2, scan_extent_mask, store++);
-      logic_count++;
-      store += offset;
-      align.store += offset_source;
+  struct rop2_loop loop;
+  const enum blit_phase_align_mode mode = rop2_loop_start(&loop, x, y, result, source);
+  loop.span = loop.reverse ? blit_span_reverse_func(rop2) : blit_span_func(rop2);
+  const int logic_count = rop2_loop_run(rop2_loop_func[rop2][mode], &loop,
+                                        rop2_shared(result->store, result->stride * result->height, source->store, source->stride * source->height));
+  BLIT_STATS_ELAPSED(start);
+  return logic_count;
+}
+
+/*
+ * Multi-plane transfers share the clipping and the loop set-up above, so they
+ * live here rather than alongside the multi-plane structure.
+ */
+int blit_rgn1_planar_rop2(struct blit_planar *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_planar *source, const enum blit_rop2 *rop2) {
+  BLIT_STATS_CLOCK(start);
+  BLIT_STATS_COUNT(blit_stats_calls, 1);
+  if (result->plane_count <= 0 || result->plane_count > BLIT_PLANAR_MAX || (source->plane_count != result->plane_count && source->plane_count != 1))
+    return 0;
+  if (!rop2_clip(x, y, result->width, result->height, source->width, source->height))
+    return 0;
+
+  /*
+   * One set of loop parameters, from plane 0 of each, serves every plane. A
+   * plane moves the destination and source pointers by whole plane strides,
+   * and whole strides leave the phase alignment alone. The planes' scans leave
+   * out the damage accumulator; the damage goes in once, below.
+   */
+  struct blit_scan plane_result = blit_planar_plane(result, 0), plane_source = blit_planar_plane(source, 0);
+  plane_result.damage = NULL;
+  if (result->damage != NULL)
+    blit_damage_add(result->damage, x->origin, y->origin, x->extent, y->extent);
+  struct rop2_loop loop;
+  const enum blit_phase_align_mode mode = rop2_loop_start(&loop, x, y, &plane_result, &plane_source);
+  const int plane_stride_source = source->plane_count == 1 ? 0 : source->plane_stride;
+  const bool shared = rop2_shared(result->store, result->plane_stride * (result->plane_count - 1) + result->stride * result->height, source->store,
+                                  source->plane_stride * (source->plane_count - 1) + source->stride * source->height);
+  int logic_count = 0;
+  for (int plane = 0; plane < result->plane_count; plane++) {
+    if ((rop2[plane] >> 2) == (rop2[plane] & 3)) {
+      struct blit_rgn1 x_rop1 = *x, y_rop1 = *y;
+      logic_count += blit_rgn1_rop1(&plane_result, &x_rop1, &y_rop1, (enum blit_rop1)(rop2[plane] & 3));
+      BLIT_STATS_COUNT(blit_stats_source_free, 1);
+    } else {
+      loop.span = loop.reverse ? blit_span_reverse_func(rop2[plane]) : blit_span_func(rop2[plane]);
+      logic_count += rop2_loop_run(rop2_loop_func[rop2[plane]][mode], &loop, shared);
     }
+    plane_result.store += result->plane_stride;
+    loop.store += result->plane_stride;
+    loop.fetch += plane_stride_source;
   }
+  BLIT_STATS_ELAPSED(start);
   return logic_count;
 }
 
@@ -311,10 +643,17 @@ int blit_rop2(struct blit_scan *result,
   return blit_rgn1_rop2(result, &x_rgn1, &y_rgn1, source, rop2);
 }
 
-void fetch_logic_mask_store(struct blit_phase_align *align, enum blit_rop2 rop2, blit_scanline_t mask, blit_scanline_t *store) {
-  *store = (*store & ~mask) | (mask & rop2_func[rop2](blit_phase_align_fetch(align), *store));
-}
-
-void fetch_logic_store(struct blit_phase_align *align, enum blit_rop2 rop2, blit_scanline_t *store) {
-  *store = rop2_func[rop2](blit_phase_align_fetch(align), *store);
+int blit_planar_rop2(struct blit_planar *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_planar *source,
+                     const int x_source, const int y_source, const enum blit_rop2 *rop2) {
+  struct blit_rgn1 x_rgn1 = {
+      .origin = x,
+      .extent = x_extent,
+      .origin_source = x_source,
+  };
+  struct blit_rgn1 y_rgn1 = {
+      .origin = y,
+      .extent = y_extent,
+      .origin_source = y_source,
+  };
+  return blit_rgn1_planar_rop2(result, &x_rgn1, &y_rgn1, source, rop2);
 }
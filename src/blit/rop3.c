@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/rop3.c
+ * \brief Ternary raster operations.
+ * \details This source file implements the functions for performing ternary
+ * raster operations on scan structures, as declared in the `blit/rop3.h`
+ * header file.
+ */
+
+#include <blit/damage.h>
+#include <blit/rop1.h>
+#include <blit/rop3.h>
+#include <blit/span.h>
+#include <blit/word.h>
+
+#include <stddef.h>
+#include <stdlib.h>
+
+#include "mux.h"
+
+/*!
+ * \brief Number of scanline bytes processed per chunk.
+ * \details The brush and source buffers for one chunk live on the stack and
+ * stay in cache while the chunk combines with the destination.
+ */
+#define ROP3_CHUNK 256
+
+/*
+ * One evaluation, for words or for bytes. The source selects within each
+ * pattern half, and the pattern selects between the halves.
+ */
+#define ROP3_MUX(type, d, s, p)                                \
+  do {                                                         \
+    const type t0 = (type)mux->a[0] ^ ((type)mux->b[0] & (d)); \
+    const type t1 = (type)mux->a[1] ^ ((type)mux->b[1] & (d)); \
+    const type t2 = (type)mux->a[2] ^ ((type)mux->b[2] & (d)); \
+    const type t3 = (type)mux->a[3] ^ ((type)mux->b[3] & (d)); \
+    const type u0 = t0 ^ ((t0 ^ t1) & (s));                    \
+    const type u1 = t2 ^ ((t2 ^ t3) & (s));                    \
+    (d) = u0 ^ ((u0 ^ u1) & (p));                              \
+  } while (0)
+
+/*!
+ * \brief Applies a ternary operation across a run of bytes.
+ * \param mux Pointer to the multiplexer masks.
+ * \param store Destination bytes, read and written.
+ * \param fetch Phase-aligned source bytes.
+ * \param pattern Expanded pattern bytes.
+ * \param count Number of bytes.
+ */
+static void rop3_span(const struct blit_mux *mux, blit_scanline_t *store, const blit_scanline_t *fetch, const blit_scanline_t *pattern, int count) {
+  int k = 0;
+  for (; k + BLIT_WORD_BYTES <= count; k += BLIT_WORD_BYTES) {
+    blit_word_t d = blit_word_load(store + k);
+    const blit_word_t s = blit_word_load(fetch + k), p = blit_word_load(pattern + k);
+    ROP3_MUX(blit_word_t, d, s, p);
+    blit_word_store(store + k, d);
+  }
+  for (; k < count; k++)
+    ROP3_MUX(blit_scanline_t, store[k], fetch[k], pattern[k]);
+}
+
+int blit_rgn1_rop3(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, const struct blit_brush *brush,
+                   enum blit_rop3 rop3) {
+  const bool uses_source = ((rop3 & 0xcc) >> 2) != (rop3 & 0x33);
+
+  /*
+   * Codes that ignore the pattern are binary operations, or unary ones if they
+   * ignore the source as well.
+   */
+  if ((rop3 >> 4) == (rop3 & 15))
+    return uses_source ? blit_rgn1_rop2(result, x, y, source, (enum blit_rop2)(rop3 & 15)) : blit_rgn1_rop1(result, x, y, (enum blit_rop1)(rop3 & 3));
+  if (brush->pattern->width <= 0 || brush->pattern->height <= 0)
+    return 0;
+
+  /*
+   * Normalise, move, and clip the regions, against the source only when the
+   * code reads it.
+   */
+  if (!uses_source) {
+    x->origin_source = x->origin;
+    y->origin_source = y->origin;
+  }
+  blit_rgn1_norm(x);
+  if (!blit_rgn1_move(x) || !blit_rgn1_clip(x, result->width - x->origin) ||
+      (uses_source && !blit_rgn1_clip(x, source->width - x->origin_source)))
+    return 0;
+  blit_rgn1_norm(y);
+  if (!blit_rgn1_move(y) || !blit_rgn1_clip(y, result->height - y->origin) ||
+      (uses_source && !blit_rgn1_clip(y, source->height - y->origin_source)))
+    return 0;
+
+  blit_scan_damage(result, x, y);
+
+  const int x_max = x->origin + x->extent - 1;
+  const int extra_scan_count = (x_max >> 3) - (x->origin >> 3);
+  int y_store = y->origin, y_fetch = y->origin_source, y_step = 1;
+  bool reverse = false;
+
+  /*
+   * Overlap, as for binary operations. Each chunk fetches all its source bytes
+   * before storing any, so working right to left chunk by chunk keeps a
+   * rightward move within the same scanlines safe.
+   */
+  if (uses_source && result->store == source->store && abs(y->origin - y->origin_source) < y->extent &&
+      abs(x->origin - x->origin_source) < x->extent) {
+    if (y->origin > y->origin_source) {
+      y_store += y->extent - 1;
+      y_fetch += y->extent - 1;
+      y_step = -1;
+    } else if (y->origin == y->origin_source && x->origin > x->origin_source) {
+      reverse = true;
+    }
+  }
+
+  struct blit_span_fetch f = {.fetch = NULL};
+  if (uses_source)
+    blit_span_fetch_start(&f, x->origin, x->origin_source, x->extent, blit_scan_find(source, x->origin_source, y_fetch));
+
+  struct blit_mux mux;
+  blit_mux_start(&mux, rop3, 4);
+  blit_scanline_t origin_mask = 0xffU >> (x->origin & 7);
+  const blit_scanline_t extent_mask = 0xffU << (7 - (x_max & 7));
+  if (extra_scan_count == 0)
+    origin_mask &= extent_mask;
+  const int chunk_count = extra_scan_count / ROP3_CHUNK + 1;
+  blit_scanline_t fetch_chunk[ROP3_CHUNK], pattern_chunk[ROP3_CHUNK];
+
+  const blit_scanline_t *fetch = f.fetch;
+  for (int extent = y->extent; extent--; y_store += y_step) {
+    blit_scanline_t *store = blit_scan_find(result, x->origin, y_store);
+    for (int chunk = 0; chunk < chunk_count; chunk++) {
+      const int k0 = (reverse ? chunk_count - 1 - chunk : chunk) * ROP3_CHUNK;
+      const int count = extra_scan_count + 1 - k0 < ROP3_CHUNK ? extra_scan_count + 1 - k0 : ROP3_CHUNK;
+      const blit_scanline_t origin = store[0], extent_byte = store[extra_scan_count];
+      blit_brush_expand(brush, ((x->origin >> 3) + k0) << 3, y_store, pattern_chunk, count);
+      if (uses_source)
+        blit_span_fetch_run(&f, fetch, k0, count, fetch_chunk);
+      rop3_span(&mux, store + k0, uses_source ? fetch_chunk : pattern_chunk, pattern_chunk, count);
+      if (k0 == 0)
+        store[0] = (origin & ~origin_mask) | (store[0] & origin_mask);
+      if (extra_scan_count > 0 && k0 + count > extra_scan_count)
+        store[extra_scan_count] = (extent_byte & ~extent_mask) | (store[extra_scan_count] & extent_mask);
+    }
+    if (uses_source)
+      fetch += y_step * source->stride;
+  }
+  return y->extent * (extra_scan_count + 1);
+}
+
+int blit_rop3(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source, const int x_source,
+              const int y_source, const struct blit_brush *brush, enum blit_rop3 rop3) {
+  struct blit_rgn1 x_rgn1 = {
+      .origin = x,
+      .extent = x_extent,
+      .origin_source = x_source,
+  };
+  struct blit_rgn1 y_rgn1 = {
+      .origin = y,
+      .extent = y_extent,
+      .origin_source = y_source,
+  };
+  return blit_rgn1_rop3(result, &x_rgn1, &y_rgn1, source, brush, rop3);
+}
@@ -0,0 +1,183 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/rotate.c
+ * \brief Rotating and transposing blits.
+ * \details This source file implements the rotating blit declared in the
+ * `blit/rotate.h` header file.
+ */
+
+#include <blit/damage.h>
+#include <blit/rotate.h>
+#include <blit/word.h>
+
+/*!
+ * \brief Number of destination bytes staged per band chunk.
+ */
+#define ROTATE_CHUNK 64
+
+/*!
+ * \brief Transposes an 8×8 bit matrix.
+ * \details Row \e i is byte \e i from the top of the word, most-significant
+ * bit first. Three rounds swap 1×1, 2×2 and 4×4 blocks across the diagonal.
+ * \param matrix The matrix.
+ * \return The transposed matrix: bit \e j of row \e i becomes bit \e i of
+ * row \e j.
+ */
+static uint64_t rotate_transpose8(uint64_t matrix) {
+  uint64_t t = (matrix ^ (matrix >> 7)) & 0x00aa00aa00aa00aaU;
+  matrix ^= t ^ (t << 7);
+  t = (matrix ^ (matrix >> 14)) & 0x0000cccc0000ccccU;
+  matrix ^= t ^ (t << 14);
+  t = (matrix ^ (matrix >> 28)) & 0x00000000f0f0f0f0U;
+  return matrix ^ t ^ (t << 28);
+}
+
+/*!
+ * \brief Fetches up to 8 bits of a scanline.
+ * \details Reads no byte beyond those holding the bits.
+ * \param fetch Scanline.
+ * \param p First bit.
+ * \param count Number of bits, 1 through 8.
+ * \param reverse True to answer the bits in reverse order.
+ * \return The bits, most-significant first, zeros after.
+ */
+static blit_scanline_t rotate_fetch(const blit_scanline_t *fetch, int p, int count, bool reverse) {
+  const int shift = p & 7;
+  unsigned int bits = (unsigned int)fetch[p >> 3] << shift;
+  if (shift + count > 8)
+    bits |= fetch[(p >> 3) + 1] >> (8 - shift);
+  bits &= 0xff00U >> count;
+  return reverse ? (blit_scanline_t)(blit_reverse((blit_scanline_t)bits) << (8 - count)) : (blit_scanline_t)bits;
+}
+
+/*!
+ * \brief One destination axis of a rotation.
+ * \details The destination coordinate \c origin plus \e i takes source
+ * coordinate \e p(i) along the axis that the rotation maps to it: `a0 + i`,
+ * or `a0 + n - 1 - i` when \c flip reverses the axis.
+ */
+struct rotate_axis {
+  int origin;
+  int a0;
+  int n;
+  bool flip;
+};
+
+static int rotate_map(const struct rotate_axis *axis, int u) { return axis->flip ? axis->a0 + axis->n - 1 - (u - axis->origin) : axis->a0 + (u - axis->origin); }
+
+/*!
+ * \brief Clips one axis.
+ * \details Keeps the source coordinates inside the source rectangle and the
+ * source scan whose destination coordinates fall inside the destination
+ * scan, then narrows the axis to them.
+ * \return True if any remain.
+ */
+static bool rotate_clip(struct rotate_axis *axis, int extent, int extent_source) {
+  int lo = axis->a0 > 0 ? axis->a0 : 0, hi = axis->a0 + axis->n < extent_source ? axis->a0 + axis->n : extent_source;
+  const int lo_result = axis->flip ? axis->a0 + axis->n + axis->origin - extent : axis->a0 - axis->origin;
+  if (lo_result > lo)
+    lo = lo_result;
+  if (lo_result + extent < hi)
+    hi = lo_result + extent;
+  if (lo >= hi)
+    return false;
+  axis->origin = axis->flip ? axis->origin + axis->a0 + axis->n - hi : axis->origin + lo - axis->a0;
+  axis->a0 = lo;
+  axis->n = hi - lo;
+  return true;
+}
+
+int blit_rgn1_rotate(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, enum blit_rotate rotate,
+                     enum blit_rop2 rop2) {
+  if (x->extent <= 0 || y->extent <= 0)
+    return 0;
+
+  /*
+   * Quarter turns and transposing swap the axes: destination columns follow
+   * source rows and destination rows follow source columns.
+   */
+  const bool swap = rotate == blit_rotate_90 || rotate == blit_rotate_270 || rotate == blit_rotate_transpose;
+  struct rotate_axis u_axis = {
+      .origin = x->origin,
+      .a0 = swap ? y->origin_source : x->origin_source,
+      .n = x->extent,
+      .flip = rotate == blit_rotate_90 || rotate == blit_rotate_180,
+  };
+  struct rotate_axis v_axis = {
+      .origin = y->origin,
+      .a0 = swap ? x->origin_source : y->origin_source,
+      .n = y->extent,
+      .flip = rotate == blit_rotate_180 || rotate == blit_rotate_270,
+  };
+  if (!rotate_clip(&u_axis, result->width, swap ? source->height : source->width) ||
+      !rotate_clip(&v_axis, result->height, swap ? source->width : source->height))
+    return 0;
+  x->origin = u_axis.origin;
+  x->extent = u_axis.n;
+  x->origin_source = swap ? v_axis.a0 : u_axis.a0;
+  y->origin = v_axis.origin;
+  y->extent = v_axis.n;
+  y->origin_source = swap ? u_axis.a0 : v_axis.a0;
+  const int u0 = u_axis.origin, u_count = u_axis.n, v0 = v_axis.origin, v_count = v_axis.n;
+
+  blit_scan_damage(result, x, y);
+  struct blit_scan plain = *result;
+  plain.damage = NULL;
+  blit_scanline_t stage[8][ROTATE_CHUNK];
+  struct blit_scan staged = BLIT_SCAN_INIT(&stage[0][0], ROTATE_CHUNK * 8, 8, ROTATE_CHUNK);
+
+  for (int v = v0; v < v0 + v_count; v += 8) {
+    const int rows = v0 + v_count - v < 8 ? v0 + v_count - v : 8;
+    for (int chunk = u0; chunk < u0 + u_count; chunk += ROTATE_CHUNK * 8) {
+      const int columns = u0 + u_count - chunk < ROTATE_CHUNK * 8 ? u0 + u_count - chunk : ROTATE_CHUNK * 8;
+      for (int k = 0; k < (columns + 7) >> 3; k++) {
+        const int u = chunk + (k << 3);
+        const int block_columns = chunk + columns - u < 8 ? chunk + columns - u : 8;
+        if (swap) {
+          /*
+           * Column j of the block is source row p_u(u + j); its 8 bits, down
+           * the block's rows, run along that source row. Gather the rows as
+           * a matrix, then transpose it into the block's rows.
+           */
+          const int p = v_axis.flip ? rotate_map(&v_axis, v + rows - 1) : rotate_map(&v_axis, v);
+          uint64_t matrix = 0U;
+          for (int j = 0; j < 8; j++) {
+            const blit_scanline_t bits = j < block_columns ? rotate_fetch(blit_scan_find(source, 0, rotate_map(&u_axis, u + j)), p, rows, v_axis.flip) : 0U;
+            matrix = (matrix << 8) | bits;
+          }
+          matrix = rotate_transpose8(matrix);
+          for (int i = 0; i < 8; i++)
+            stage[i][k] = (blit_scanline_t)(matrix >> (56 - 8 * i));
+        } else {
+          /*
+           * Row i of the block is source row p_v(v + i), read forwards or
+           * backwards.
+           */
+          const int p = u_axis.flip ? rotate_map(&u_axis, u + block_columns - 1) : rotate_map(&u_axis, u);
+          for (int i = 0; i < rows; i++)
+            stage[i][k] = rotate_fetch(blit_scan_find(source, 0, rotate_map(&v_axis, v + i)), p, block_columns, u_axis.flip);
+        }
+      }
+      (void)blit_rop2(&plain, chunk, v, columns, rows, &staged, 0, 0, rop2);
+    }
+  }
+  return y->extent * (((x->origin + x->extent - 1) >> 3) - (x->origin >> 3) + 1);
+}
+
+int blit_rotate(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source,
+                const int x_source, const int y_source, enum blit_rotate rotate, enum blit_rop2 rop2) {
+  struct blit_rgn1 x_rgn1 = {
+      .origin = x,
+      .extent = x_extent,
+      .origin_source = x_source,
+  };
+  struct blit_rgn1 y_rgn1 = {
+      .origin = y,
+      .extent = y_extent,
+      .origin_source = y_source,
+  };
+  return blit_rgn1_rotate(result, &x_rgn1, &y_rgn1, source, rotate, rop2);
+}
@@ -0,0 +1,30 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/run.h
+ * \brief Unary operations on runs of pixels.
+ * \details This private header file, shared by the unary and compressed
+ * blits but not installed, declares the scanline kernel beneath
+ * `blit_rgn1_rop1()`.
+ */
+
+#ifndef __BLIT_RUN_H__
+#define __BLIT_RUN_H__
+
+#include <blit/rop1.h>
+
+/*!
+ * \brief Applies a unary operation to pixels \c x0 up to \c x1 of a scanline.
+ * \details Edge-masks the first and last bytes and sets, clears or inverts
+ * whole bytes between.
+ * \param store First byte of the destination scanline.
+ * \param x0 First pixel.
+ * \param x1 Past the last pixel; greater than \c x0.
+ * \param rop1 The unary operation, anything but `blit_rop1_D`.
+ * \return The number of logic operations performed.
+ */
+int blit_run_rop1(blit_scanline_t *store, int x0, int x1, enum blit_rop1 rop1);
+
+#endif /* __BLIT_RUN_H__ */
@@ -0,0 +1,69 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/scroll.c
+ * \brief Scrolling within a scan.
+ * \details This source file implements the function for scrolling a rectangle
+ * of a scan in place, as declared in the `blit/scroll.h` header file.
+ */
+
+#include <blit/rop1.h>
+#include <blit/scroll.h>
+
+int blit_scroll(struct blit_scan *scan, int x, int y, int x_extent, int y_extent, int dx, int dy, bool fill) {
+  /*
+   * Clip the rectangle to the scan. The rectangle is its own source, so the
+   * source origins track the destination origins.
+   */
+  struct blit_rgn1 x_rgn1 = {
+      .origin = x,
+      .extent = x_extent,
+      .origin_source = x,
+  };
+  struct blit_rgn1 y_rgn1 = {
+      .origin = y,
+      .extent = y_extent,
+      .origin_source = y,
+  };
+  blit_rgn1_norm(&x_rgn1);
+  if (!blit_rgn1_move(&x_rgn1) || !blit_rgn1_clip(&x_rgn1, scan->width - x_rgn1.origin))
+    return 0;
+  blit_rgn1_norm(&y_rgn1);
+  if (!blit_rgn1_move(&y_rgn1) || !blit_rgn1_clip(&y_rgn1, scan->height - y_rgn1.origin))
+    return 0;
+
+  /*
+   * Exposed extents. A move of the whole width or height or more exposes the
+   * entire rectangle. Compare without negating, for offsets of `INT_MIN`.
+   */
+  const int x_exposed = dx >= x_rgn1.extent || dx <= -x_rgn1.extent ? x_rgn1.extent : (dx < 0 ? -dx : dx);
+  const int y_exposed = dy >= y_rgn1.extent || dy <= -y_rgn1.extent ? y_rgn1.extent : (dy < 0 ? -dy : dy);
+  const enum blit_rop1 rop1 = fill ? blit_rop1_1 : blit_rop1_0;
+  int logic_count = 0;
+
+  /*
+   * Move what stays inside the rectangle.
+   */
+  if (x_exposed < x_rgn1.extent && y_exposed < y_rgn1.extent) {
+    logic_count += blit_rop2(scan, x_rgn1.origin + (dx > 0 ? dx : 0), y_rgn1.origin + (dy > 0 ? dy : 0), x_rgn1.extent - x_exposed,
+                             y_rgn1.extent - y_exposed, scan, x_rgn1.origin + (dx < 0 ? -dx : 0), y_rgn1.origin + (dy < 0 ? -dy : 0),
+                             blit_rop2_copy);
+  }
+
+  /*
+   * Fill the exposed rows across the whole width, then the exposed columns
+   * down the remaining rows.
+   */
+  const int y_kept = dy > 0 ? y_rgn1.origin + y_exposed : y_rgn1.origin;
+  if (y_exposed > 0) {
+    const int y_fill = dy > 0 ? y_rgn1.origin : y_rgn1.origin + y_rgn1.extent - y_exposed;
+    logic_count += blit_rop1(scan, x_rgn1.origin, y_fill, x_rgn1.extent, y_exposed, rop1);
+  }
+  if (x_exposed > 0 && y_exposed < y_rgn1.extent) {
+    const int x_fill = dx > 0 ? x_rgn1.origin : x_rgn1.origin + x_rgn1.extent - x_exposed;
+    logic_count += blit_rop1(scan, x_fill, y_kept, x_exposed, y_rgn1.extent - y_exposed, rop1);
+  }
+  return logic_count;
+}
@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/shift.c
+ * \brief Pre-shifted source cache.
+ * \details This source file implements the cache declared in the
+ * `blit/shift.h` header file.
+ */
+
+#include <blit/shift.h>
+
+void blit_shift_cache_start(struct blit_shift_cache *cache, blit_scanline_t *store, size_t size) {
+  cache->store = store;
+  cache->slot_size = size / BLIT_SHIFT_SLOT_MAX;
+  for (int i = 0; i < BLIT_SHIFT_SLOT_MAX; i++)
+    cache->slots[i].key = NULL;
+  cache->clock = 0UL;
+  cache->hits = 0UL;
+  cache->misses = 0UL;
+}
+
+void blit_shift_cache_forget(struct blit_shift_cache *cache, const struct blit_scan *source) {
+  for (int i = 0; i < BLIT_SHIFT_SLOT_MAX; i++)
+    if (cache->slots[i].key == source->store)
+      cache->slots[i].key = NULL;
+}
+
+const struct blit_scan *blit_shift_cache_find(struct blit_shift_cache *cache, const struct blit_scan *source, int shift) {
+  if (shift < 1 || shift > 7)
+    return NULL;
+  const int stride = (source->width + shift + 7) >> 3;
+  if ((size_t)stride * (size_t)source->height > cache->slot_size)
+    return NULL;
+
+  /*
+   * A hit must match the source's geometry as well as its store, in case the
+   * caller reinterpreted the store without forgetting it. Otherwise evict the
+   * free or least-recently-used slot.
+   */
+  struct blit_shift_slot *slot = cache->slots;
+  for (int i = 0; i < BLIT_SHIFT_SLOT_MAX; i++) {
+    struct blit_shift_slot *next = cache->slots + i;
+    if (next->key == source->store && next->shift == shift && next->scan.width == source->width + shift && next->scan.height == source->height) {
+      next->used = ++cache->clock;
+      cache->hits++;
+      return &next->scan;
+    }
+    if (slot->key != NULL && (next->key == NULL || next->used < slot->used))
+      slot = next;
+  }
+
+  /*
+   * The copy costs one shifting blit, once.
+   */
+  const struct blit_scan scan = BLIT_SCAN_INIT(cache->store + (slot - cache->slots) * cache->slot_size, source->width + shift, source->height, stride);
+  slot->key = source->store;
+  slot->shift = shift;
+  slot->used = ++cache->clock;
+  slot->scan = scan;
+  (void)blit_rop2(&slot->scan, shift, 0, source->width, source->height, source, 0, 0, blit_rop2_copy);
+  cache->misses++;
+  return &slot->scan;
+}
+
+int blit_rgn1_rop2_shifted(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, struct blit_shift_cache *cache,
+                           enum blit_rop2 rop2) {
+  /*
+   * Moving into positive space keeps the phase difference, and keeps the
+   * shifted source origin clear of the copy's undefined leading bits.
+   */
+  blit_rgn1_norm(x);
+  if (!blit_rgn1_move(x))
+    return 0;
+  const int shift = (x->origin - x->origin_source) & 7;
+  const struct blit_scan *shifted = NULL;
+  if (shift != 0 && (rop2 >> 2) != (rop2 & 3) && result->store != source->store)
+    shifted = blit_shift_cache_find(cache, source, shift);
+  if (shifted == NULL)
+    return blit_rgn1_rop2(result, x, y, source, rop2);
+
+  x->origin_source += shift;
+  const int logic_count = blit_rgn1_rop2(result, x, y, shifted, rop2);
+  x->origin_source -= shift;
+  return logic_count;
+}
+
+int blit_rop2_shifted(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source,
+                      const int x_source, const int y_source, struct blit_shift_cache *cache, enum blit_rop2 rop2) {
+  struct blit_rgn1 x_rgn1 = {
+      .origin = x,
+      .extent = x_extent,
+      .origin_source = x_source,
+  };
+  struct blit_rgn1 y_rgn1 = {
+      .origin = y,
+      .extent = y_extent,
+      .origin_source = y_source,
+  };
+  return blit_rgn1_rop2_shifted(result, &x_rgn1, &y_rgn1, source, cache, rop2);
+}
@@ -0,0 +1,530 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/span.c
+ * \brief Unmasked scanline span kernels.
+ * \details This source file implements the span kernels declared in the
+ * `blit/span.h` header file: portable kernels working a machine word at a
+ * time, and x86 kernels working 16, 32 or 64 bytes at a time. Every kernel
+ * hands its tail, the bytes left over after its last whole vector, to the
+ * next narrower kernel.
+ */
+
+#include <blit/span.h>
+#include <blit/word.h>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define BLIT_SPAN_X86
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define BLIT_TARGET(isa)
+#else
+#include <immintrin.h>
+#define BLIT_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+/*!
+ * \brief Source operand, a byte, word or vector.
+ */
+#define S (fetch)
+
+/*!
+ * \brief Destination operand, a byte, word or vector.
+ */
+#define D (store)
+
+/*!
+ * \brief List of raster operations in code order.
+ * \details Expands \c X once per raster operation with the instruction set
+ * prefix, the operation's reverse Polish name and its expression. Passing the
+ * prefix through, rather than wrapping \c X in another macro, keeps the names
+ * \c D and \c S from expanding as operands before they are pasted into
+ * identifiers. The expressions use operator macros `AND`, `OR`, `XOR`,
+ * `NOT`, `ZERO` and `ONES` rather than C operators so that each instruction
+ * set can define them in terms of its own intrinsics. The order matches the
+ * `blit_rop2` enumeration, whose codes are the truth tables of the
+ * expressions.
+ */
+#define SPAN_ROP2(X, isa)      \
+  X(isa, 0, ZERO)              \
+  X(isa, DSon, NOT(OR(D, S)))  \
+  X(isa, DSna, AND(D, NOT(S))) \
+  X(isa, Sn, NOT(S))           \
+  X(isa, SDna, AND(S, NOT(D))) \
+  X(isa, Dn, NOT(D))           \
+  X(isa, DSx, XOR(D, S))       \
+  X(isa, DSan, NOT(AND(D, S))) \
+  X(isa, DSa, AND(D, S))       \
+  X(isa, DSxn, NOT(XOR(D, S))) \
+  X(isa, D, D)                 \
+  X(isa, DSno, OR(D, NOT(S)))  \
+  X(isa, S, S)                 \
+  X(isa, SDno, OR(S, NOT(D)))  \
+  X(isa, DSo, OR(D, S))        \
+  X(isa, 1, ONES)
+
+/*!
+ * \brief Expands to the address of a kernel, for building dispatch tables.
+ */
+#define SPAN_ENTRY(isa, revPolish, x) &span_##isa##_##revPolish,
+
+/*
+ * Portable kernels. Words hold bytes in host order; see blit/word.h for why
+ * that never matters. The byte tail reuses the word operators and truncates.
+ */
+#define AND(a, b) ((a) & (b))
+#define OR(a, b) ((a) | (b))
+#define XOR(a, b) ((a) ^ (b))
+#define NOT(a) (~(a))
+#define ZERO ((blit_word_t)0x00U)
+#define ONES (~(blit_word_t)0x00U)
+
+#define SPAN_PORTABLE(isa, revPolish, x)                                                                               \
+  static void span_portable_##revPolish(blit_scanline_t *result, const blit_scanline_t *source, int shift, int count); \
+  void span_portable_##revPolish(blit_scanline_t *result, const blit_scanline_t *source, int shift, int count) {       \
+    for (; count >= BLIT_WORD_BYTES; count -= BLIT_WORD_BYTES) {                                                       \
+      const blit_word_t fetch = blit_word_funnel(source, shift);                                                       \
+      const blit_word_t store = blit_word_load(result);                                                                \
+      (void)fetch;                                                                                                     \
+      (void)store;                                                                                                     \
+      blit_word_store(result, x);                                                                                      \
+      source += BLIT_WORD_BYTES;                                                                                       \
+      result += BLIT_WORD_BYTES;                                                                                       \
+    }                                                                                                                  \
+    for (; count > 0; count--) {                                                                                       \
+      const blit_word_t fetch = blit_funnel(source++, shift);                                                          \
+      const blit_word_t store = *result;                                                                               \
+      (void)fetch;                                                                                                     \
+      (void)store;                                                                                                     \
+      *result++ = (blit_scanline_t)(x);                                                                                \
+    }                                                                                                                  \
+  }
+
+SPAN_ROP2(SPAN_PORTABLE, portable)
+
+/*!
+ * \brief Portable span kernels in raster operation code order.
+ */
+static const blit_span_func_t span_portable[] = {SPAN_ROP2(SPAN_ENTRY, portable)};
+
+/*
+ * Reverse kernels. Same words and bytes as the portable kernels, visited from
+ * the end of the span: the ragged bytes first, then whole words.
+ */
+#define SPAN_REVERSE(isa, revPolish, x)                                                                               \
+  static void span_reverse_##revPolish(blit_scanline_t *result, const blit_scanline_t *source, int shift, int count); \
+  void span_reverse_##revPolish(blit_scanline_t *result, const blit_scanline_t *source, int shift, int count) {       \
+    for (; count % BLIT_WORD_BYTES != 0; count--) {                                                                   \
+      const blit_word_t fetch = blit_funnel(source + count - 1, shift);                                               \
+      const blit_word_t store = result[count - 1];                                                                    \
+      (void)fetch;                                                                                                    \
+      (void)store;                                                                                                    \
+      result[count - 1] = (blit_scanline_t)(x);                                                                       \
+    }                                                                                                                 \
+    for (; count > 0; count -= BLIT_WORD_BYTES) {                                                                     \
+      const blit_word_t fetch = blit_word_funnel(source + count - BLIT_WORD_BYTES, shift);                            \
+      const blit_word_t store = blit_word_load(result + count - BLIT_WORD_BYTES);                                     \
+      (void)fetch;                                                                                                    \
+      (void)store;                                                                                                    \
+      blit_word_store(result + count - BLIT_WORD_BYTES, x);                                                           \
+    }                                                                                                                 \
+  }
+
+SPAN_ROP2(SPAN_REVERSE, reverse)
+
+/*!
+ * \brief Reverse span kernels in raster operation code order.
+ */
+static const blit_span_func_t span_reverse[] = {SPAN_ROP2(SPAN_ENTRY, reverse)};
+
+#undef AND
+#undef OR
+#undef XOR
+#undef NOT
+#undef ZERO
+#undef ONES
+
+#ifdef BLIT_SPAN_X86
+
+/*!
+ * \brief Defines a vector span kernel.
+ * \details The vector kernels share one shape. Each instruction set supplies a
+ * vector type `isa##_t`, a width `isa##_BYTES`, unaligned `isa##_load` and
+ * `isa##_store`, and `isa##_funnel`, which shifts sixteen-bit lanes and masks
+ * off the bits that cross byte boundaries. An aligned source skips the funnel
+ * and its second load. Bytes left over drop through to the portable kernel,
+ * after `isa##_leave`, which clears the upper halves of the vector registers
+ * for instruction sets wider than 128 bits.
+ * \param isa Instruction set prefix.
+ * \param revPolish The reverse Polish name of the raster operation.
+ * \param x The expression defining the raster operation using D and S.
+ */
+#define SPAN_VECTOR(isa, revPolish, x)                                                                                \
+  BLIT_TARGET(isa##_TARGET)                                                                                           \
+  static void span_##isa##_##revPolish(blit_scanline_t *result, const blit_scanline_t *source, int shift, int count); \
+  BLIT_TARGET(isa##_TARGET)                                                                                           \
+  void span_##isa##_##revPolish(blit_scanline_t *result, const blit_scanline_t *source, int shift, int count) {       \
+    const isa##_t ones = isa##_ones();                                                                                \
+    (void)ones;                                                                                                       \
+    if (shift == 0) {                                                                                                 \
+      for (; count >= isa##_BYTES; count -= isa##_BYTES) {                                                            \
+        const isa##_t fetch = isa##_load(source);                                                                     \
+        const isa##_t store = isa##_load(result);                                                                     \
+        (void)fetch;                                                                                                  \
+        (void)store;                                                                                                  \
+        isa##_store(result, x);                                                                                       \
+        source += isa##_BYTES;                                                                                        \
+        result += isa##_BYTES;                                                                                        \
+      }                                                                                                               \
+    } else {                                                                                                          \
+      for (; count >= isa##_BYTES; count -= isa##_BYTES) {                                                            \
+        const isa##_t fetch = isa##_funnel(source, shift);                                                            \
+        const isa##_t store = isa##_load(result);                                                                     \
+        (void)fetch;                                                                                                  \
+        (void)store;                                                                                                  \
+        isa##_store(result, x);                                                                                       \
+        source += isa##_BYTES;                                                                                        \
+        result += isa##_BYTES;                                                                                        \
+      }                                                                                                               \
+    }                                                                                                                 \
+    isa##_leave();                                                                                                    \
+    span_portable_##revPolish(result, source, shift, count);                                                          \
+  }
+
+/*
+ * SSE2 kernels, sixteen bytes at a time.
+ */
+typedef __m128i sse2_t;
+#define sse2_BYTES 16
+#define sse2_TARGET "sse2"
+
+BLIT_TARGET("sse2") static inline __m128i sse2_ones(void) { return _mm_set1_epi32(-1); }
+
+static inline void sse2_leave(void) {}
+
+BLIT_TARGET("sse2") static inline __m128i sse2_load(const blit_scanline_t *fetch) { return _mm_loadu_si128((const __m128i *)fetch); }
+
+BLIT_TARGET("sse2") static inline void sse2_store(blit_scanline_t *store, __m128i x) { _mm_storeu_si128((__m128i *)store, x); }
+
+BLIT_TARGET("sse2") static inline __m128i sse2_funnel(const blit_scanline_t *fetch, int shift) {
+  const __m128i hi = _mm_and_si128(_mm_sll_epi16(sse2_load(fetch), _mm_cvtsi32_si128(shift)), _mm_set1_epi8((char)(0xffU << shift)));
+  const __m128i lo = _mm_and_si128(_mm_srl_epi16(sse2_load(fetch + 1), _mm_cvtsi32_si128(8 - shift)), _mm_set1_epi8((char)(0xffU >> (8 - shift))));
+  return _mm_or_si128(hi, lo);
+}
+
+#define AND(a, b) _mm_and_si128((a), (b))
+#define OR(a, b) _mm_or_si128((a), (b))
+#define XOR(a, b) _mm_xor_si128((a), (b))
+#define NOT(a) _mm_xor_si128((a), ones)
+#define ZERO _mm_setzero_si128()
+#define ONES ones
+
+SPAN_ROP2(SPAN_VECTOR, sse2)
+
+#undef AND
+#undef OR
+#undef XOR
+#undef NOT
+#undef ZERO
+#undef ONES
+
+/*!
+ * \brief SSE2 span kernels in raster operation code order.
+ */
+static const blit_span_func_t span_sse2[] = {SPAN_ROP2(SPAN_ENTRY, sse2)};
+
+/*
+ * AVX2 kernels, thirty-two bytes at a time.
+ */
+typedef __m256i avx2_t;
+#define avx2_BYTES 32
+#define avx2_TARGET "avx2"
+
+BLIT_TARGET("avx2") static inline __m256i avx2_ones(void) { return _mm256_set1_epi32(-1); }
+
+/*
+ * Clear the upper halves of the vector registers before handing the tail to
+ * the portable kernel. Compilers do so on return, but not always before a
+ * tail call, and legacy-encoded instructions after dirty upper halves stall.
+ */
+BLIT_TARGET("avx2") static inline void avx2_leave(void) { _mm256_zeroupper(); }
+
+BLIT_TARGET("avx2") static inline __m256i avx2_load(const blit_scanline_t *fetch) { return _mm256_loadu_si256((const __m256i *)fetch); }
+
+BLIT_TARGET("avx2") static inline void avx2_store(blit_scanline_t *store, __m256i x) { _mm256_storeu_si256((__m256i *)store, x); }
+
+BLIT_TARGET("avx2") static inline __m256i avx2_funnel(const blit_scanline_t *fetch, int shift) {
+  const __m256i hi = _mm256_and_si256(_mm256_sll_epi16(avx2_load(fetch), _mm_cvtsi32_si128(shift)), _mm256_set1_epi8((char)(0xffU << shift)));
+  const __m256i lo =
+      _mm256_and_si256(_mm256_srl_epi16(avx2_load(fetch + 1), _mm_cvtsi32_si128(8 - shift)), _mm256_set1_epi8((char)(0xffU >> (8 - shift))));
+  return _mm256_or_si256(hi, lo);
+}
+
+#define AND(a, b) _mm256_and_si256((a), (b))
+#define OR(a, b) _mm256_or_si256((a), (b))
+#define XOR(a, b) _mm256_xor_si256((a), (b))
+#define NOT(a) _mm256_xor_si256((a), ones)
+#define ZERO _mm256_setzero_si256()
+#define ONES ones
+
+SPAN_ROP2(SPAN_VECTOR, avx2)
+
+#undef AND
+#undef OR
+#undef XOR
+#undef NOT
+#undef ZERO
+#undef ONES
+
+/*!
+ * \brief AVX2 span kernels in raster operation code order.
+ */
+static const blit_span_func_t span_avx2[] = {SPAN_ROP2(SPAN_ENTRY, avx2)};
+
+/*
+ * AVX-512 kernels, sixty-four bytes at a time. Sixteen-bit lane shifts need
+ * the byte-and-word extension, AVX-512BW, on top of the foundation.
+ */
+typedef __m512i avx512_t;
+#define avx512_BYTES 64
+#define avx512_TARGET "avx512f,avx512bw"
+
+BLIT_TARGET("avx512f,avx512bw") static inline __m512i avx512_ones(void) { return _mm512_set1_epi32(-1); }
+
+BLIT_TARGET("avx512f,avx512bw") static inline void avx512_leave(void) { _mm256_zeroupper(); }
+
+BLIT_TARGET("avx512f,avx512bw") static inline __m512i avx512_load(const blit_scanline_t *fetch) { return _mm512_loadu_si512((const void *)fetch); }
+
+BLIT_TARGET("avx512f,avx512bw") static inline void avx512_store(blit_scanline_t *store, __m512i x) { _mm512_storeu_si512((void *)store, x); }
+
+BLIT_TARGET("avx512f,avx512bw") static inline __m512i avx512_funnel(const blit_scanline_t *fetch, int shift) {
+  const __m512i hi = _mm512_and_si512(_mm512_sll_epi16(avx512_load(fetch), _mm_cvtsi32_si128(shift)), _mm512_set1_epi8((char)(0xffU << shift)));
+  const __m512i lo =
+      _mm512_and_si512(_mm512_srl_epi16(avx512_load(fetch + 1), _mm_cvtsi32_si128(8 - shift)), _mm512_set1_epi8((char)(0xffU >> (8 - shift))));
+  return _mm512_or_si512(hi, lo);
+}
+
+#define AND(a, b) _mm512_and_si512((a), (b))
+#define OR(a, b) _mm512_or_si512((a), (b))
+#define XOR(a, b) _mm512_xor_si512((a), (b))
+#define NOT(a) _mm512_xor_si512((a), ones)
+#define ZERO _mm512_setzero_si512()
+#define ONES ones
+
+SPAN_ROP2(SPAN_VECTOR, avx512)
+
+#undef AND
+#undef OR
+#undef XOR
+#undef NOT
+#undef ZERO
+#undef ONES
+
+/*!
+ * \brief AVX-512 span kernels in raster operation code order.
+ */
+static const blit_span_func_t span_avx512[] = {SPAN_ROP2(SPAN_ENTRY, avx512)};
+
+#endif /* BLIT_SPAN_X86 */
+
+/*!
+ * \brief Kernel tables indexed by instruction set.
+ * \details Null where the build has no kernels for an instruction set.
+ */
+static const blit_span_func_t *const span_isa_func[] = {
+    span_portable,
+#ifdef BLIT_SPAN_X86
+    span_sse2,
+    span_avx2,
+    span_avx512,
+#else
+    NULL,
+    NULL,
+    NULL,
+#endif
+};
+
+/*!
+ * \brief Atomic loads, stores and swaps of shared words.
+ * \details The selection and the processor probe each live in one word that
+ * threads may read and write concurrently. GCC and Clang have atomic
+ * built-ins; Microsoft's compiler has interlocked intrinsics.
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+#define SPAN_LOAD(p) _InterlockedCompareExchange((p), 0, 0)
+#define SPAN_STORE(p, v) (void)_InterlockedExchange((p), (v))
+#define SPAN_SWAP(p, expected, v) (_InterlockedCompareExchange((p), (v), (expected)) == (expected))
+#else
+#define SPAN_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define SPAN_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define SPAN_SWAP(p, expected, v) __atomic_compare_exchange_n((p), &(long){(expected)}, (v), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#endif
+
+/*!
+ * \brief Processor feature bits.
+ */
+enum span_cpu {
+  span_cpu_sse2,
+  span_cpu_avx2,
+  span_cpu_avx512,
+  span_cpu_popcnt,
+  span_cpu_probed,
+};
+
+/*!
+ * \brief Selected instruction set plus one, or zero before first use.
+ * \details The kernel tables are constant, so this one word is the whole
+ * selection.
+ */
+static volatile long span_selected = 0;
+
+/*!
+ * \brief Processor features, one bit per `enum span_cpu` value, plus the
+ * probed bit; zero before the first probe.
+ */
+static volatile long span_features = 0;
+
+/*!
+ * \brief Probes the processor's features.
+ * \details GCC and Clang answer from their own processor feature cache, which
+ * also checks that the operating system saves the wider vector registers.
+ * Microsoft's compiler needs the checks spelt out: CPUID leaf 1 for SSE2,
+ * POPCNT, AVX and OS-enabled extended state, XGETBV for the register state
+ * the operating system saves, and CPUID leaf 7 for AVX2 and AVX-512.
+ * \return The feature bits.
+ */
+static long cpu_probe(void) {
+  long features = 1L << span_cpu_probed;
+#if defined(BLIT_SPAN_X86) && defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  const int max_leaf = info[0];
+  __cpuid(info, 1);
+  if ((info[3] & (1 << 26)) != 0)
+    features |= 1L << span_cpu_sse2;
+  if ((info[2] & (1 << 23)) != 0)
+    features |= 1L << span_cpu_popcnt;
+  if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 || max_leaf < 7)
+    return features;
+  const unsigned long long xcr0 = _xgetbv(0);
+  __cpuidex(info, 7, 0);
+  if ((xcr0 & 0x06U) == 0x06U && (info[1] & (1 << 5)) != 0)
+    features |= 1L << span_cpu_avx2;
+  if ((xcr0 & 0xe6U) == 0xe6U && (info[1] & (1 << 16)) != 0 && (info[1] & (1 << 30)) != 0)
+    features |= 1L << span_cpu_avx512;
+#elif defined(BLIT_SPAN_X86)
+  if (__builtin_cpu_supports("sse2"))
+    features |= 1L << span_cpu_sse2;
+  if (__builtin_cpu_supports("popcnt"))
+    features |= 1L << span_cpu_popcnt;
+  if (__builtin_cpu_supports("avx2"))
+    features |= 1L << span_cpu_avx2;
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+    features |= 1L << span_cpu_avx512;
+#endif
+  return features;
+}
+
+/*!
+ * \brief Answers the processor's features, probing them once.
+ * \details Racing first callers probe alike and store the same word
+ * atomically; later callers only load it.
+ */
+static long cpu_features(void) {
+  long features = SPAN_LOAD(&span_features);
+  if (features == 0) {
+    features = cpu_probe();
+    SPAN_STORE(&span_features, features);
+  }
+  return features;
+}
+
+bool blit_span_cpu_popcnt(void) { return (cpu_features() & (1L << span_cpu_popcnt)) != 0; }
+
+bool blit_span_isa_supported(enum blit_span_isa isa) {
+  if (isa == blit_span_isa_portable)
+    return true;
+  if (isa < blit_span_isa_portable || isa > blit_span_isa_avx512 || span_isa_func[isa] == NULL)
+    return false;
+  return (cpu_features() & (1L << (isa - blit_span_isa_sse2 + span_cpu_sse2))) != 0;
+}
+
+bool blit_span_isa_select(enum blit_span_isa isa) {
+  if (!blit_span_isa_supported(isa))
+    return false;
+  SPAN_STORE(&span_selected, (long)isa + 1L);
+  return true;
+}
+
+enum blit_span_isa blit_span_isa_selected(void) {
+  (void)blit_span_func(blit_rop2_0);
+  return (enum blit_span_isa)(SPAN_LOAD(&span_selected) - 1L);
+}
+
+/*
+ * Selecting on first use rather than at load time keeps the library free of
+ * platform-specific constructor hooks. The first use installs the widest
+ * supported instruction set only if nothing is selected yet, so it never
+ * overrides an explicit selection.
+ */
+blit_span_func_t blit_span_func(enum blit_rop2 rop2) {
+  long selected = SPAN_LOAD(&span_selected);
+  if (selected == 0) {
+    enum blit_span_isa isa = blit_span_isa_avx512;
+    while (!blit_span_isa_supported(isa))
+      isa--;
+    (void)SPAN_SWAP(&span_selected, 0L, (long)isa + 1L);
+    selected = SPAN_LOAD(&span_selected);
+  }
+  return span_isa_func[selected - 1L][rop2];
+}
+
+blit_span_func_t blit_span_reverse_func(enum blit_rop2 rop2) { return span_reverse[rop2]; }
+
+void blit_span_fetch_start(struct blit_span_fetch *fetch, int x, int x_source, int extent, const blit_scanline_t *store) {
+  struct blit_phase_align align;
+  blit_phase_align_start(&align, x, x_source & 7, store);
+  fetch->fetch = align.store;
+  fetch->mode = blit_phase_align_mode(&align);
+  fetch->shift = align.shift;
+  fetch->fetch_count = (((x_source & 7) + extent - 1) >> 3) + 1;
+  fetch->extra_scan_count = (((x & 7) + extent - 1) >> 3);
+  fetch->span = blit_span_func(blit_rop2_S);
+}
+
+static blit_scanline_t span_fetch_byte(const struct blit_span_fetch *fetch, const blit_scanline_t *store, int k) {
+  switch (fetch->mode) {
+  case blit_phase_align_left_shift:
+    return (blit_scanline_t)((store[k] << fetch->shift) | (k + 1 < fetch->fetch_count ? store[k + 1] >> (8 - fetch->shift) : 0));
+  case blit_phase_align_none:
+    return store[k];
+  default:
+    return (blit_scanline_t)((k > 0 ? store[k - 1] << (8 - fetch->shift) : 0) | (k < fetch->fetch_count ? store[k] >> fetch->shift : 0));
+  }
+}
+
+/*
+ * Bytes strictly between the first and last of the scanline go through the
+ * copy span kernel, which reads no further than the binary loops do.
+ */
+void blit_span_fetch_run(const struct blit_span_fetch *fetch, const blit_scanline_t *store, int k0, int count, blit_scanline_t *run) {
+  const int first = k0 > 1 ? k0 : 1;
+  const int last = k0 + count < fetch->extra_scan_count ? k0 + count : fetch->extra_scan_count;
+  for (int k = k0; k < first && k < k0 + count; k++)
+    run[k - k0] = span_fetch_byte(fetch, store, k);
+  if (first < last) {
+    if (fetch->mode == blit_phase_align_right_shift)
+      (*fetch->span)(run + first - k0, store + first - 1, 8 - fetch->shift, last - first);
+    else
+      (*fetch->span)(run + first - k0, store + first, fetch->shift, last - first);
+  }
+  for (int k = last > first ? last : first; k < k0 + count; k++)
+    run[k - k0] = span_fetch_byte(fetch, store, k);
+}
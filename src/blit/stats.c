@@ -0,0 +1,100 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/stats.c
+ * \brief Hot-path statistics.
+ * \details This source file implements the statistics declared in the
+ * `blit/stats.h` header file.
+ */
+
+#include <blit/stats.h>
+
+#include <stddef.h>
+#include <string.h>
+
+#ifdef BLIT_STATS
+
+#ifdef _WIN32
+#include <windows.h>
+#define STATS_THREAD_LOCAL __declspec(thread)
+#else
+#include <time.h>
+#define STATS_THREAD_LOCAL _Thread_local
+#endif
+
+/*!
+ * \brief Atomic loads, stores and additions of global counters.
+ * \details Threads blitting concurrently all add to the global statistics.
+ * GCC and Clang have atomic built-ins; Microsoft's compiler has interlocked
+ * functions. Relaxed ordering suffices since no counter guards other data.
+ */
+#if defined(_MSC_VER) && !defined(__clang__)
+#define STATS_LOAD(p) (uint64_t)InterlockedCompareExchange64((volatile LONG64 *)(p), 0, 0)
+#define STATS_STORE(p, v) (void)InterlockedExchange64((volatile LONG64 *)(p), (LONG64)(v))
+#define STATS_ADD(p, n) (void)InterlockedExchangeAdd64((volatile LONG64 *)(p), (LONG64)(n))
+#else
+#define STATS_LOAD(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define STATS_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define STATS_ADD(p, n) (void)__atomic_fetch_add((p), (n), __ATOMIC_RELAXED)
+#endif
+
+static struct blit_stats global;
+
+static STATS_THREAD_LOCAL struct blit_stats *captured = NULL;
+
+void blit_stats_read(struct blit_stats *stats) {
+  for (int i = 0; i < blit_stats_counter_max; i++)
+    stats->count[i] = STATS_LOAD(global.count + i);
+}
+
+void blit_stats_reset(void) {
+  for (int i = 0; i < blit_stats_counter_max; i++)
+    STATS_STORE(global.count + i, 0U);
+}
+
+struct blit_stats *blit_stats_capture(struct blit_stats *stats) {
+  struct blit_stats *previous = captured;
+  captured = stats;
+  return previous;
+}
+
+void blit_stats_count(enum blit_stats_counter counter, uint64_t n) {
+  STATS_ADD(global.count + counter, n);
+  if (captured != NULL)
+    captured->count[counter] += n;
+}
+
+uint64_t blit_stats_clock(void) {
+#ifdef _WIN32
+  LARGE_INTEGER count, frequency;
+  (void)QueryPerformanceCounter(&count);
+  (void)QueryPerformanceFrequency(&frequency);
+  return (uint64_t)((double)count.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+  struct timespec now;
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)now.tv_sec * 1000000000U + (uint64_t)now.tv_nsec;
+#endif
+}
+
+#else
+
+void blit_stats_read(struct blit_stats *stats) { (void)memset(stats, 0, sizeof(*stats)); }
+
+void blit_stats_reset(void) {}
+
+struct blit_stats *blit_stats_capture(struct blit_stats *stats) {
+  (void)stats;
+  return NULL;
+}
+
+void blit_stats_count(enum blit_stats_counter counter, uint64_t n) {
+  (void)counter;
+  (void)n;
+}
+
+uint64_t blit_stats_clock(void) { return 0U; }
+
+#endif /* BLIT_STATS */
@@ -0,0 +1,225 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/stretch.c
+ * \brief Integer scaling blits.
+ * \details This source file implements the stretch blit declared in the
+ * `blit/stretch.h` header file.
+ */
+
+#include <blit/damage.h>
+#include <blit/span.h>
+#include <blit/stretch.h>
+
+/*!
+ * \brief Number of destination bytes staged per column chunk.
+ */
+#define STRETCH_CHUNK 512
+
+/*!
+ * \brief Largest scale with a bit-spreading table.
+ */
+#define STRETCH_SPREAD_MAX 8
+
+/*!
+ * \brief Bit-spreading tables.
+ * \details Entry `[n - 2][bits]` holds the \e 8n bits that enlarging the
+ * source byte \c bits by \e n gives, right aligned, the leftmost first.
+ */
+#define STRETCH_SPREAD_BIT(bits, bit, n) ((uint64_t)(((bits) >> (bit)) & 1) * (((uint64_t)1 << (n)) - 1U) << ((bit) * (n)))
+#define STRETCH_SPREAD(n, bits)                                                                                                                                \
+  (STRETCH_SPREAD_BIT(bits, 0, n) | STRETCH_SPREAD_BIT(bits, 1, n) | STRETCH_SPREAD_BIT(bits, 2, n) | STRETCH_SPREAD_BIT(bits, 3, n) |                         \
+   STRETCH_SPREAD_BIT(bits, 4, n) | STRETCH_SPREAD_BIT(bits, 5, n) | STRETCH_SPREAD_BIT(bits, 6, n) | STRETCH_SPREAD_BIT(bits, 7, n))
+#define STRETCH_SPREAD_4(n, bits) STRETCH_SPREAD(n, bits), STRETCH_SPREAD(n, (bits) + 1), STRETCH_SPREAD(n, (bits) + 2), STRETCH_SPREAD(n, (bits) + 3)
+#define STRETCH_SPREAD_16(n, bits) STRETCH_SPREAD_4(n, bits), STRETCH_SPREAD_4(n, (bits) + 4), STRETCH_SPREAD_4(n, (bits) + 8), STRETCH_SPREAD_4(n, (bits) + 12)
+#define STRETCH_SPREAD_64(n, bits)                                                                                                                             \
+  STRETCH_SPREAD_16(n, bits), STRETCH_SPREAD_16(n, (bits) + 16), STRETCH_SPREAD_16(n, (bits) + 32), STRETCH_SPREAD_16(n, (bits) + 48)
+#define STRETCH_SPREAD_256(n) {STRETCH_SPREAD_64(n, 0), STRETCH_SPREAD_64(n, 64), STRETCH_SPREAD_64(n, 128), STRETCH_SPREAD_64(n, 192)}
+
+static const uint64_t stretch_spread[STRETCH_SPREAD_MAX - 1][256] = {
+    STRETCH_SPREAD_256(2), STRETCH_SPREAD_256(3), STRETCH_SPREAD_256(4), STRETCH_SPREAD_256(5),
+    STRETCH_SPREAD_256(6), STRETCH_SPREAD_256(7), STRETCH_SPREAD_256(8),
+};
+
+/*!
+ * \brief Staged bit stream.
+ * \details Collects bits most-significant first into whole bytes, after
+ * dropping the first \c skip bits, until \c room bits have gone in.
+ */
+struct stretch_out {
+  blit_scanline_t *store;
+  uint64_t pending;
+  int pending_count;
+  int skip;
+  int room;
+};
+
+static void stretch_put(struct stretch_out *out, uint64_t bits, int count) {
+  if (count > 32) {
+    stretch_put(out, bits >> 32, count - 32);
+    bits &= 0xffffffffU;
+    count = 32;
+  }
+  if (out->skip > 0) {
+    if (out->skip >= count) {
+      out->skip -= count;
+      return;
+    }
+    count -= out->skip;
+    bits &= ((uint64_t)1 << count) - 1U;
+    out->skip = 0;
+  }
+  if (count > out->room) {
+    bits >>= count - out->room;
+    count = out->room;
+  }
+  out->room -= count;
+  out->pending = (out->pending << count) | bits;
+  out->pending_count += count;
+  while (out->pending_count >= 8) {
+    out->pending_count -= 8;
+    *out->store++ = (blit_scanline_t)(out->pending >> out->pending_count);
+  }
+  out->pending &= ((uint64_t)1 << out->pending_count) - 1U;
+}
+
+static void stretch_flush(struct stretch_out *out) {
+  if (out->pending_count > 0)
+    *out->store = (blit_scanline_t)(out->pending << (8 - out->pending_count));
+}
+
+/*!
+ * \brief Clips one axis of a stretch in destination pixels.
+ * \details Destination pixel \e u takes source pixel `origin_source +
+ * floor(u * down / up)`. Keeps the pixels that land inside both scans, then
+ * moves the region to the first of them.
+ * \param phase Receives how far into its source pixel's run of destination
+ * pixels the first destination pixel falls.
+ * \return True if any pixels remain.
+ */
+static bool stretch_clip(struct blit_rgn1 *rgn1, int up, int down, int extent, int extent_source, int *phase) {
+  int lo = 0, hi = rgn1->extent;
+  if (-rgn1->origin > lo)
+    lo = -rgn1->origin;
+  if (extent - rgn1->origin < hi)
+    hi = extent - rgn1->origin;
+  if (rgn1->origin_source < 0) {
+    const int at_least = (-rgn1->origin_source * up + down - 1) / down;
+    if (at_least > lo)
+      lo = at_least;
+  }
+  const int available = extent_source - rgn1->origin_source;
+  if (available <= 0)
+    return false;
+  const int below = (available * up + down - 1) / down;
+  if (below < hi)
+    hi = below;
+  if (lo >= hi)
+    return false;
+  rgn1->origin += lo;
+  rgn1->extent = hi - lo;
+  rgn1->origin_source += lo * down / up;
+  *phase = lo * down % up;
+  return true;
+}
+
+/*!
+ * \brief Stages one source scanline, stretched, for a column chunk.
+ * \param stage Receives the destination bits, the first at the most
+ * significant bit of the first byte.
+ * \param fetch Source scanline.
+ * \param x_source Source pixel of the phase's first destination pixel.
+ * \param u0 First destination pixel of the chunk, counted from the phase.
+ * \param count Number of destination pixels in the chunk.
+ */
+static void stretch_stage(blit_scanline_t *stage, const blit_scanline_t *fetch, int x_source, int up, int down, int u0, int count) {
+  if (up == 1 && down == 1) {
+    /*
+     * Same width: the chunk is a plain run of source bits, fetched a byte or
+     * more at a time with the span kernels' fetch.
+     */
+    struct blit_span_fetch f;
+    blit_span_fetch_start(&f, 0, x_source + u0, count, fetch + ((x_source + u0) >> 3));
+    blit_span_fetch_run(&f, f.fetch, 0, f.extra_scan_count + 1, stage);
+    return;
+  }
+  struct stretch_out out = {.store = stage, .room = count};
+  if (up == 1) {
+    for (int u = u0; u < u0 + count; u++) {
+      const int bit = x_source + u * down;
+      stretch_put(&out, (fetch[bit >> 3] >> (7 - (bit & 7))) & 1U, 1);
+    }
+  } else {
+    blit_scanline_t source_chunk[STRETCH_CHUNK + 1];
+    const int first = u0 / up, last = (u0 + count - 1) / up;
+    struct blit_span_fetch f;
+    blit_span_fetch_start(&f, 0, x_source + first, last - first + 1, fetch + ((x_source + first) >> 3));
+    blit_span_fetch_run(&f, f.fetch, 0, f.extra_scan_count + 1, source_chunk);
+    out.skip = u0 - first * up;
+    int remaining = last - first + 1;
+    for (int k = 0; remaining > 0; k++, remaining -= 8) {
+      const int pixels = remaining < 8 ? remaining : 8;
+      const blit_scanline_t bits = source_chunk[k];
+      if (up <= STRETCH_SPREAD_MAX) {
+        stretch_put(&out, stretch_spread[up - 2][bits] >> ((8 - pixels) * up), pixels * up);
+      } else {
+        for (int bit = 7; bit > 7 - pixels; bit--)
+          for (int n = up; n > 0; n -= 32)
+            stretch_put(&out, (bits >> bit) & 1 ? 0xffffffffU >> (32 - (n < 32 ? n : 32)) : 0U, n < 32 ? n : 32);
+      }
+    }
+  }
+  stretch_flush(&out);
+}
+
+int blit_rgn1_stretch(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_scan *source, int x_scale, int y_scale,
+                      enum blit_rop2 rop2) {
+  const int x_up = x_scale > 1 ? x_scale : 1, x_down = x_scale < -1 ? -x_scale : 1;
+  const int y_up = y_scale > 1 ? y_scale : 1, y_down = y_scale < -1 ? -y_scale : 1;
+  int x_phase, y_phase;
+  if (x->extent <= 0 || y->extent <= 0 || !stretch_clip(x, x_up, x_down, result->width, source->width, &x_phase) ||
+      !stretch_clip(y, y_up, y_down, result->height, source->height, &y_phase))
+    return 0;
+
+  blit_scan_damage(result, x, y);
+
+  /*
+   * Transfer from a one-row stage with a stride of zero: the row repeats down
+   * as many destination rows as the transfer's extent. The destination's
+   * damage went in whole, above.
+   */
+  struct blit_scan plain = *result;
+  plain.damage = NULL;
+  blit_scanline_t stage[STRETCH_CHUNK + 8];
+  struct blit_scan staged = BLIT_SCAN_INIT(stage, STRETCH_CHUNK * 8, 0, 0);
+  for (int v = 0; v < y->extent;) {
+    const int v_source = y->origin_source + (v + y_phase) * y_down / y_up;
+    const int rows = y_up == 1 ? 1 : (y_up - (v + y_phase) % y_up < y->extent - v ? y_up - (v + y_phase) % y_up : y->extent - v);
+    const blit_scanline_t *fetch = source->store + source->stride * v_source;
+    for (int u0 = 0; u0 < x->extent; u0 += STRETCH_CHUNK * 8) {
+      const int count = x->extent - u0 < STRETCH_CHUNK * 8 ? x->extent - u0 : STRETCH_CHUNK * 8;
+      stretch_stage(stage, fetch, x->origin_source, x_up, x_down, u0 + x_phase, count);
+      staged.height = rows;
+      (void)blit_rop2(&plain, x->origin + u0, y->origin + v, count, rows, &staged, 0, 0, rop2);
+    }
+    v += rows;
+  }
+  return y->extent * (((x->origin + x->extent - 1) >> 3) - (x->origin >> 3) + 1);
+}
+
+int blit_stretch(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *source,
+                 const int x_source, const int y_source, int x_scale, int y_scale, enum blit_rop2 rop2) {
+  struct blit_rgn1 x_rgn1 = {
+      .origin = x,
+      .extent = x_extent,
+      .origin_source = x_source,
+  };
+  struct blit_rgn1 y_rgn1 = {
+      .origin = y,
+      .extent = y_extent,
+      .origin_source = y_source,
+  };
+  return blit_rgn1_stretch(result, &x_rgn1, &y_rgn1, source, x_scale, y_scale, rop2);
+}
@@ -0,0 +1,170 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/text.c
+ * \brief Glyph atlases and text runs.
+ * \details This source file implements the fonts and text runs declared in
+ * the `blit/text.h` header file.
+ */
+
+#include <blit/damage.h>
+#include <blit/text.h>
+
+#include <limits.h>
+
+#include "mux.h"
+
+/*!
+ * \brief Fetches a glyph scanline.
+ * \param atlas Pointer to the atlas scan structure.
+ * \param x Left of the glyph in the atlas.
+ * \param y Scanline in the atlas.
+ * \param width Width of the glyph, from 1 to `BLIT_TEXT_NARROW`.
+ * \return The scanline's pixels, left-justified in 32 bits.
+ */
+static uint32_t text_fetch(const struct blit_scan *atlas, int x, int y, int width) {
+  const blit_scanline_t *fetch = blit_scan_find(atlas, x, y);
+  const int count = ((x & 7) + width + 7) >> 3;
+  uint32_t bits = 0U;
+  for (int k = 0; k < 4; k++)
+    bits = (bits << 8) | (k < count ? fetch[k] : 0U);
+  return (bits << (x & 7)) & ~(0xffffffffU >> width);
+}
+
+/*!
+ * \brief Answers whether a glyph takes the narrow-glyph path.
+ * \details Narrow glyphs lie wholly inside the atlas, so that fetching their
+ * scanlines reads nothing outside it. Others go the general way, which clips
+ * against the atlas as against any source.
+ */
+static bool text_narrow(const struct blit_font *font, const struct blit_glyph *glyph) {
+  return glyph->width > 0 && glyph->width <= BLIT_TEXT_NARROW && glyph->x_atlas >= 0 && glyph->y_atlas >= 0 &&
+         glyph->x_atlas + glyph->width <= font->atlas->width && glyph->y_atlas + glyph->height <= font->atlas->height;
+}
+
+size_t blit_font_shift_count(const struct blit_font *font) {
+  int height = 0;
+  for (int index = 0; index < font->count; index++)
+    if (font->glyph[index].height > height)
+      height = font->glyph[index].height;
+  return (size_t)font->count * (size_t)height * 8U;
+}
+
+void blit_font_shift(struct blit_font *font, uint32_t *shifted) {
+  const int height = (int)(blit_font_shift_count(font) / 8U / (font->count > 0 ? (size_t)font->count : 1U));
+  for (int index = 0; index < font->count; index++) {
+    const struct blit_glyph *glyph = font->glyph + index;
+    uint32_t *rows = shifted + (size_t)index * (size_t)height * 8U;
+    for (int row = 0; row < height; row++)
+      for (int phase = 0; phase < 8; phase++)
+        rows[row * 8 + phase] = row < glyph->height && text_narrow(font, glyph)
+                                    ? text_fetch(font->atlas, glyph->x_atlas, glyph->y_atlas + row, glyph->width) >> phase
+                                    : 0U;
+  }
+  font->shifted = shifted;
+  font->shifted_height = height;
+}
+
+int blit_text_width(const struct blit_font *font, const char *text, int length) {
+  int width = 0;
+  for (int i = 0; i < length; i++) {
+    const int index = (unsigned char)text[i] - font->first;
+    if (index >= 0 && index < font->count)
+      width += font->glyph[index].advance;
+  }
+  return width;
+}
+
+int blit_text(struct blit_scan *result, int x, int y, const struct blit_font *font, const char *text, int length, enum blit_rop2 rop2) {
+  /*
+   * Bound the whole run, skipping empty glyphs, and clip the bounds against
+   * the destination once. A run wholly inside draws every narrow glyph with no
+   * further clipping; one wholly outside draws nothing.
+   */
+  int x_min = INT_MAX, y_min = INT_MAX, x_max = INT_MIN, y_max = INT_MIN;
+  for (int i = 0, pen = x; i < length; i++) {
+    const int index = (unsigned char)text[i] - font->first;
+    if (index < 0 || index >= font->count)
+      continue;
+    const struct blit_glyph *glyph = font->glyph + index;
+    const int x_glyph = pen + glyph->x_offset, y_glyph = y + glyph->y_offset;
+    pen += glyph->advance;
+    if (glyph->width <= 0 || glyph->height <= 0)
+      continue;
+    if (x_glyph < x_min)
+      x_min = x_glyph;
+    if (y_glyph < y_min)
+      y_min = y_glyph;
+    if (x_glyph + glyph->width > x_max)
+      x_max = x_glyph + glyph->width;
+    if (y_glyph + glyph->height > y_max)
+      y_max = y_glyph + glyph->height;
+  }
+  const int x0 = x_min > 0 ? x_min : 0, y0 = y_min > 0 ? y_min : 0;
+  const int x1 = x_max < result->width ? x_max : result->width, y1 = y_max < result->height ? y_max : result->height;
+  if (x0 >= x1 || y0 >= y1)
+    return 0;
+  const bool inside = x0 == x_min && y0 == y_min && x1 == x_max && y1 == y_max;
+
+  struct blit_mux mux;
+  blit_mux_start(&mux, rop2, 2);
+  struct blit_scan plain = *result;
+  plain.damage = NULL;
+  int logic_count = 0;
+  for (int i = 0; i < length; i++) {
+    const int index = (unsigned char)text[i] - font->first;
+    if (index < 0 || index >= font->count)
+      continue;
+    const struct blit_glyph *glyph = font->glyph + index;
+    const int x_glyph = x + glyph->x_offset, y_glyph = y + glyph->y_offset;
+    x += glyph->advance;
+    if (glyph->width <= 0 || glyph->height <= 0)
+      continue;
+
+    /*
+     * In a run straddling an edge, glyphs wholly off it draw nothing and
+     * glyphs straddling it go the general way, as do glyphs too wide for the
+     * narrow path or not wholly inside the atlas.
+     */
+    if (!inside) {
+      if (x_glyph >= x1 || y_glyph >= y1 || x_glyph + glyph->width <= x0 || y_glyph + glyph->height <= y0)
+        continue;
+      if (x_glyph < x0 || y_glyph < y0 || x_glyph + glyph->width > x1 || y_glyph + glyph->height > y1) {
+        logic_count += blit_rop2(&plain, x_glyph, y_glyph, glyph->width, glyph->height, font->atlas, glyph->x_atlas, glyph->y_atlas, rop2);
+        continue;
+      }
+    }
+    if (!text_narrow(font, glyph)) {
+      logic_count += blit_rop2(&plain, x_glyph, y_glyph, glyph->width, glyph->height, font->atlas, glyph->x_atlas, glyph->y_atlas, rop2);
+      continue;
+    }
+
+    /*
+     * One 32-bit source and mask per scanline, at most four bytes, with the
+     * row pointers stepping by stride.
+     */
+    const int phase = x_glyph & 7, count = (phase + glyph->width + 7) >> 3;
+    const uint32_t mask = (0xffffffffU << (32 - glyph->width)) >> phase;
+    const uint32_t *shifted = font->shifted != NULL ? font->shifted + (size_t)index * (size_t)font->shifted_height * 8U + phase : NULL;
+    blit_scanline_t *store = blit_scan_find(result, x_glyph, y_glyph);
+    for (int row = 0; row < glyph->height; row++, store += result->stride) {
+      const uint32_t bits = shifted != NULL ? shifted[row * 8] : text_fetch(font->atlas, glyph->x_atlas, glyph->y_atlas + row, glyph->width) >> phase;
+      for (int k = 0; k < count; k++) {
+        const uint8_t s = (uint8_t)(bits >> (24 - 8 * k)), m = (uint8_t)(mask >> (24 - 8 * k));
+        const uint8_t d = store[k];
+        const uint8_t t0 = (uint8_t)mux.a[0] ^ ((uint8_t)mux.b[0] & d), t1 = (uint8_t)mux.a[1] ^ ((uint8_t)mux.b[1] & d);
+        store[k] = d ^ ((t0 ^ ((t0 ^ t1) & s) ^ d) & m);
+      }
+    }
+    logic_count += glyph->height * count;
+  }
+
+  if (rop2 != blit_rop2_D) {
+    const struct blit_rgn1 x_rgn1 = {.origin = x0, .extent = x1 - x0};
+    const struct blit_rgn1 y_rgn1 = {.origin = y0, .extent = y1 - y0};
+    blit_scan_damage(result, &x_rgn1, &y_rgn1);
+  }
+  return logic_count;
+}
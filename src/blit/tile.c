@@ -0,0 +1,92 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file blit/tile.c
+ * \brief Tiled pattern fills.
+ * \details This source file implements the tiling functions declared in the
+ * `blit/tile.h` header file.
+ */
+
+#include <blit/damage.h>
+#include <blit/rop1.h>
+#include <blit/span.h>
+#include <blit/tile.h>
+
+/*!
+ * \brief Number of scanline bytes expanded per chunk.
+ */
+#define TILE_CHUNK 512
+
+int blit_rgn1_tile(struct blit_scan *result, struct blit_rgn1 *x, struct blit_rgn1 *y, const struct blit_brush *brush, enum blit_rop2 rop2) {
+  if (brush->pattern->width <= 0 || brush->pattern->height <= 0)
+    return 0;
+  if ((rop2 >> 2) == (rop2 & 3))
+    return blit_rgn1_rop1(result, x, y, (enum blit_rop1)(rop2 & 3));
+
+  x->origin_source = x->origin;
+  blit_rgn1_norm(x);
+  if (!blit_rgn1_move(x) || !blit_rgn1_clip(x, result->width - x->origin))
+    return 0;
+  y->origin_source = y->origin;
+  blit_rgn1_norm(y);
+  if (!blit_rgn1_move(y) || !blit_rgn1_clip(y, result->height - y->origin))
+    return 0;
+
+  blit_scan_damage(result, x, y);
+
+  const int x_max = x->origin + x->extent - 1;
+  const int extra_scan_count = (x_max >> 3) - (x->origin >> 3);
+  blit_scanline_t origin_mask = 0xffU >> (x->origin & 7);
+  const blit_scanline_t extent_mask = 0xffU << (7 - (x_max & 7));
+  if (extra_scan_count == 0)
+    origin_mask &= extent_mask;
+  const blit_span_func_t span = blit_span_func(rop2);
+  const int period = brush->pattern->height < y->extent ? brush->pattern->height : y->extent;
+  const int stride = result->stride * brush->pattern->height;
+  blit_scanline_t pattern[TILE_CHUNK];
+
+  /*
+   * Column chunks, then pattern rows, then the destination rows that share
+   * each pattern row. Each destination byte still goes through the kernel
+   * exactly once, and each pattern row expands once per chunk however tall
+   * the region.
+   */
+  for (int k0 = 0; k0 <= extra_scan_count; k0 += TILE_CHUNK) {
+    const int count = extra_scan_count + 1 - k0 < TILE_CHUNK ? extra_scan_count + 1 - k0 : TILE_CHUNK;
+    for (int v = y->origin; v < y->origin + period; v++) {
+      blit_brush_expand(brush, ((x->origin >> 3) + k0) << 3, v, pattern, count);
+      blit_scanline_t *store = blit_scan_find(result, x->origin, v);
+      for (int extent = (y->origin + y->extent - v + brush->pattern->height - 1) / brush->pattern->height; extent--; store += stride) {
+        const blit_scanline_t origin = store[0], extent_byte = store[extra_scan_count];
+        (*span)(store + k0, pattern, 0, count);
+        if (k0 == 0)
+          store[0] = (origin & ~origin_mask) | (store[0] & origin_mask);
+        if (extra_scan_count > 0 && k0 + count > extra_scan_count)
+          store[extra_scan_count] = (extent_byte & ~extent_mask) | (store[extra_scan_count] & extent_mask);
+      }
+    }
+  }
+  return y->extent * (extra_scan_count + 1);
+}
+
+int blit_tile(struct blit_scan *result, const int x, const int y, const int x_extent, const int y_extent, const struct blit_scan *pattern,
+              const int x_pattern, const int y_pattern, enum blit_rop2 rop2) {
+  const struct blit_brush brush = {
+      .pattern = pattern,
+      .x = x_pattern,
+      .y = y_pattern,
+  };
+  struct blit_rgn1 x_rgn1 = {
+      .origin = x,
+      .extent = x_extent,
+      .origin_source = x,
+  };
+  struct blit_rgn1 y_rgn1 = {
+      .origin = y,
+      .extent = y_extent,
+      .origin_source = y,
+  };
+  return blit_rgn1_tile(result, &x_rgn1, &y_rgn1, &brush, rop2);
+}
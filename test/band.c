@@ -0,0 +1,97 @@
+#include <blit/cmd.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+/*
+ * Collects bands into a whole page, checking that they arrive in order.
+ */
+struct band_sink {
+  struct blit_scan *page;
+  int y;
+  int stop;
+};
+
+static bool band_collect(void *context, const struct blit_scan *band, int y) {
+  struct band_sink *sink = context;
+  assert(y == sink->y && band->width == sink->page->width && y + band->height <= sink->page->height);
+  for (int v = 0; v < band->height; v++)
+    (void)memcpy(blit_scan_find(sink->page, 0, y + v), blit_scan_find(band, 0, v), (size_t)sink->page->stride);
+  sink->y += band->height;
+  return sink->y < sink->stop;
+}
+
+int test_band() {
+  BLIT_SCAN_DEFINE_STATIC(image, 300, 100);
+  BLIT_SCAN_DEFINE_STATIC(expected, 300, 100);
+  BLIT_SCAN_DEFINE_STATIC(source, 200, 120);
+  BLIT_SCAN_DEFINE_STATIC(band, 304, 7);
+  BLIT_CMD_LIST_DEFINE(list, 128);
+  struct blit_scan page = BLIT_SCAN_INIT(NULL, 300, 100, 0);
+  const size_t size = sizeof(image_store);
+  unsigned int seed = 21U;
+
+  for (size_t j = 0; j < sizeof(source_store); j++)
+    source.store[j] = (blit_scanline_t)lcg(&seed);
+
+  /*
+   * Batches of random commands against the virtual page, some off the edges,
+   * some opaque covers, some abutting. Banded, they must match the same
+   * commands run on a whole, initially clear, page.
+   */
+  for (int batch = 0; batch < 100; batch++) {
+    (void)memset(expected.store, 0, size);
+    (void)memset(image.store, 0xa5, size);
+    blit_cmd_list_clear(&list);
+
+    int expected_logic_count = 0;
+    while (list.count < list.capacity - 2) {
+      const enum blit_rop2 rop2 = (enum blit_rop2)(lcg(&seed) % 16U);
+      const int x = (int)(lcg(&seed) % 330U) - 15, y = (int)(lcg(&seed) % 120U) - 10;
+      const int x_extent = (int)(lcg(&seed) % 120U) - 5, y_extent = (int)(lcg(&seed) % 50U) - 5;
+      const int x_source = (int)(lcg(&seed) % 220U) - 10, y_source = (int)(lcg(&seed) % 130U) - 5;
+      expected_logic_count += blit_rop2(&expected, x, y, x_extent, y_extent, &source, x_source, y_source, rop2);
+      if (blit_cmd_rop2(&list, &page, x, y, x_extent, y_extent, &source, x_source, y_source, rop2) < 0)
+        return EXIT_FAILURE;
+      if ((lcg(&seed) & 3U) == 0) {
+        expected_logic_count += blit_rop2(&expected, x + x_extent, y, 9, y_extent, &source, x_source + x_extent, y_source, rop2);
+        if (blit_cmd_rop2(&list, &page, x + x_extent, y, 9, y_extent, &source, x_source + x_extent, y_source, rop2) < 0)
+          return EXIT_FAILURE;
+      }
+    }
+
+    struct band_sink sink = {&image, 0, page.height};
+    const int logic_count = blit_cmd_list_band(&list, &page, &band, band_collect, &sink);
+    if (logic_count != expected_logic_count || sink.y != page.height || memcmp(image.store, expected.store, size) != 0) {
+      (void)printf("batch=%d\n", batch);
+      return EXIT_FAILURE;
+    }
+  }
+
+  /*
+   * The consumer can stop early.
+   */
+  struct band_sink sink = {&image, 0, 20};
+  (void)blit_cmd_list_band(&list, &page, &band, band_collect, &sink);
+  assert(sink.y == 21);
+
+  /*
+   * A band narrower than the page, or a command that reads the page, runs
+   * nothing.
+   */
+  struct blit_scan narrow = band;
+  narrow.width = page.width - 1;
+  sink.y = 0;
+  if (blit_cmd_list_band(&list, &page, &narrow, band_collect, &sink) != 0 || sink.y != 0)
+    return EXIT_FAILURE;
+  if (blit_cmd_rop2(&list, &page, 0, 0, 8, 8, &page, 8, 0, blit_rop2_xor) < 0)
+    return EXIT_FAILURE;
+  if (blit_cmd_list_band(&list, &page, &band, band_collect, &sink) != 0 || sink.y != 0)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
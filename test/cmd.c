@@ -0,0 +1,104 @@
+#include <blit/cmd.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+int test_cmd() {
+  BLIT_SCAN_DEFINE_STATIC(image, 640, 480);
+  BLIT_SCAN_DEFINE_STATIC(expected, 640, 480);
+  BLIT_SCAN_DEFINE_STATIC(source, 320, 240);
+  BLIT_CMD_LIST_DEFINE(list, 256);
+  const size_t size = (size_t)(image.stride * image.height);
+  unsigned int seed = 9U;
+
+  for (size_t j = 0; j < sizeof(source_store); j++)
+    source.store[j] = (blit_scanline_t)lcg(&seed);
+
+  /*
+   * Batches of random commands, some off the edges, some tiles that merge,
+   * some opaque covers, and in every fourth batch some that read from the
+   * destination. Running the batch must match running each command on its own
+   * in record order, image and logic counts.
+   */
+  for (int batch = 0; batch < 200; batch++) {
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = expected.store[j] = (blit_scanline_t)lcg(&seed);
+    blit_cmd_list_clear(&list);
+
+    int expected_logic_count = 0, logic_counts[256];
+    while (list.count < list.capacity - 8) {
+      const unsigned int kind = lcg(&seed) % 8U;
+      const enum blit_rop2 rop2 = (enum blit_rop2)(lcg(&seed) % 16U);
+      const struct blit_scan *from = (batch & 3) == 3 && kind == 0 ? &expected : &source;
+      const int x = (int)(lcg(&seed) % 700U) - 30, y = (int)(lcg(&seed) % 520U) - 20;
+      const int x_source = (int)(lcg(&seed) % 340U) - 10, y_source = (int)(lcg(&seed) % 260U) - 10;
+      if (kind == 1) {
+        /*
+         * A row of abutting tiles from abutting source.
+         */
+        const int tiles = 2 + (int)(lcg(&seed) % 6U);
+        const int width = 1 + (int)(lcg(&seed) % 40U), height = 1 + (int)(lcg(&seed) % 40U);
+        const bool down = lcg(&seed) & 1U;
+        for (int k = 0; k < tiles; k++) {
+          const int u = down ? 0 : k * width, v = down ? k * height : 0;
+          logic_counts[list.count] = blit_rop2(&expected, x + u, y + v, width, height, &source, x_source + u, y_source + v, rop2);
+          expected_logic_count += logic_counts[list.count];
+          if (blit_cmd_rop2(&list, &image, x + u, y + v, width, height, &source, x_source + u, y_source + v, rop2) < 0)
+            return EXIT_FAILURE;
+        }
+        continue;
+      }
+      const int x_extent = (int)(lcg(&seed) % (kind == 2 ? 600U : 80U)) - 5;
+      const int y_extent = (int)(lcg(&seed) % (kind == 2 ? 400U : 80U)) - 5;
+      const enum blit_rop2 cover = kind == 2 ? blit_rop2_copy : rop2;
+      const int index = blit_cmd_rop2(&list, &image, x, y, x_extent, y_extent, from == &expected ? &image : &source, x_source, y_source, cover);
+      if (index < 0)
+        return EXIT_FAILURE;
+      logic_counts[index] = blit_rop2(&expected, x, y, x_extent, y_extent, from, x_source, y_source, cover);
+      expected_logic_count += logic_counts[index];
+    }
+
+    const int logic_count = blit_cmd_list_run(&list);
+    for (int i = 0; i < list.count; i++)
+      assert(list.cmds[i].logic_count == logic_counts[i]);
+    if (logic_count != expected_logic_count || memcmp(expected.store, image.store, size) != 0) {
+      (void)printf("batch=%d\n", batch);
+      return EXIT_FAILURE;
+    }
+  }
+
+  /*
+   * Two destination scans over the same storage, the second starting 300 rows
+   * down. The second command lands in an earlier band of its own scan than
+   * the first, yet must still run after it.
+   */
+  struct blit_scan view = image;
+  view.store += 300 * view.stride;
+  view.height -= 300;
+  for (size_t j = 0; j < size; j++)
+    image.store[j] = expected.store[j] = (blit_scanline_t)lcg(&seed);
+  blit_cmd_list_clear(&list);
+  (void)blit_rop2(&expected, 0, 300, 640, 10, &source, 0, 0, blit_rop2_copy);
+  (void)blit_rop2(&expected, 0, 300, 640, 10, &source, 0, 100, blit_rop2_xor);
+  if (blit_cmd_rop2(&list, &image, 0, 300, 640, 10, &source, 0, 0, blit_rop2_copy) < 0 ||
+      blit_cmd_rop2(&list, &view, 0, 0, 640, 10, &source, 0, 100, blit_rop2_xor) < 0)
+    return EXIT_FAILURE;
+  (void)blit_cmd_list_run(&list);
+  if (memcmp(expected.store, image.store, size) != 0)
+    return EXIT_FAILURE;
+
+  /*
+   * A full list refuses more commands.
+   */
+  BLIT_CMD_LIST_DEFINE(small, 1);
+  if (blit_cmd_rop2(&small, &image, 0, 0, 8, 8, &source, 0, 0, blit_rop2_copy) != 0)
+    return EXIT_FAILURE;
+  if (blit_cmd_rop2(&small, &image, 8, 0, 8, 8, &source, 8, 0, blit_rop2_copy) != -1)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
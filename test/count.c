@@ -0,0 +1,89 @@
+#include <blit/count.h>
+#include <blit/span.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+int test_count() {
+  BLIT_SCAN_DEFINE_STATIC(image, 500, 40);
+  BLIT_SCAN_DEFINE_STATIC(copy, 500, 40);
+  static int first[40], last[40];
+  const enum blit_span_isa isa = blit_span_isa_selected();
+  unsigned int seed = 17U;
+
+  /*
+   * Random regions, partly off every edge, over images from sparse to dense,
+   * under every instruction set, against a bit-wise reference. The image must
+   * not change.
+   */
+  for (int i = 0; i < 2000; i++) {
+    (void)blit_span_isa_select((enum blit_span_isa)(i % 4));
+    const unsigned int density = i % 5 == 0 ? 1000U : 1U + lcg(&seed) % 16U;
+    for (size_t j = 0; j < sizeof(image_store); j++) {
+      blit_scanline_t byte = 0U;
+      for (int b = 0; b < 8; b++)
+        byte = (blit_scanline_t)((byte << 1) | (lcg(&seed) % density == 0U ? 1U : 0U));
+      image.store[j] = byte;
+    }
+    (void)memcpy(copy.store, image.store, sizeof(image_store));
+
+    const int x_extent = (int)(lcg(&seed) % 560U) - 30, y_extent = (int)(lcg(&seed) % 50U) - 5;
+    const int x = (int)(lcg(&seed) % 540U) - 20, y = (int)(lcg(&seed) % 50U) - 5;
+    struct blit_rgn1 x_rgn1 = {.origin = x, .extent = x_extent}, y_rgn1 = {.origin = y, .extent = y_extent};
+    struct blit_count count;
+    const uint64_t bits = blit_rgn1_count(&image, &x_rgn1, &y_rgn1, &count, first, last);
+    assert(memcmp(copy.store, image.store, sizeof(image_store)) == 0);
+    if (blit_count(&image, x, y, x_extent, y_extent, NULL) != bits)
+      return EXIT_FAILURE;
+
+    /*
+     * The reference clips the normalised rectangle directly.
+     */
+    const int x0 = x_extent < 0 ? x + x_extent : x, y0 = y_extent < 0 ? y + y_extent : y;
+    const int u0 = x0 > 0 ? x0 : 0, v0 = y0 > 0 ? y0 : 0;
+    const int u1 = x0 + abs(x_extent) < image.width ? x0 + abs(x_extent) : image.width;
+    const int v1 = y0 + abs(y_extent) < image.height ? y0 + abs(y_extent) : image.height;
+    uint64_t expected = 0U;
+    int x_min = image.width, x_max = -1, y_min = -1, y_max = -1;
+    for (int v = v0; v < v1; v++) {
+      int row_first = -1, row_last = -1;
+      for (int u = u0; u < u1; u++) {
+        if (!bit_get(&image, u, v))
+          continue;
+        expected++;
+        if (row_first < 0)
+          row_first = u;
+        row_last = u;
+      }
+      if (u0 < u1) {
+        assert(y_rgn1.origin == v0 && x_rgn1.origin == u0 && x_rgn1.extent == u1 - u0);
+        assert(first[v - v0] == row_first && last[v - v0] == row_last);
+      }
+      if (row_first < 0)
+        continue;
+      if (row_first < x_min)
+        x_min = row_first;
+      if (row_last > x_max)
+        x_max = row_last;
+      if (y_min < 0)
+        y_min = v;
+      y_max = v;
+    }
+    if (bits != expected || count.count != expected) {
+      (void)printf("x=%d y=%d x_extent=%d y_extent=%d bits=%llu expected=%llu\n", x, y, x_extent, y_extent, (unsigned long long)bits,
+                   (unsigned long long)expected);
+      return EXIT_FAILURE;
+    }
+    const bool bounded = expected == 0U ? count.x_extent == 0 && count.y_extent == 0
+                                        : count.x == x_min && count.y == y_min && count.x_extent == x_max - x_min + 1 && count.y_extent == y_max - y_min + 1;
+    if (!bounded)
+      return EXIT_FAILURE;
+  }
+  (void)blit_span_isa_select(isa);
+
+  return EXIT_SUCCESS;
+}
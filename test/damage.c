@@ -0,0 +1,100 @@
+#include <blit/damage.h>
+#include <blit/rop1.h>
+#include <blit/rop3.h>
+#include <blit/scroll.h>
+#include <blit/tile.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+static bool damaged(const struct blit_damage *damage, int x, int y) {
+  for (int i = 0; i < damage->count; i++) {
+    const struct blit_damage_rect *rect = damage->rects + i;
+    if (x >= rect->x && x < rect->x + rect->x_extent && y >= rect->y && y < rect->y + rect->y_extent)
+      return true;
+  }
+  return false;
+}
+
+int test_damage() {
+  struct blit_damage damage = {.count = 0};
+  struct blit_damage_rect bounds;
+
+  /*
+   * Abutting tiles merge; covered rectangles vanish; too many collapse to the
+   * bounding box.
+   */
+  if (blit_damage_bounds(&damage, &bounds))
+    return EXIT_FAILURE;
+  blit_damage_add(&damage, 0, 0, 0, 10);
+  assert(damage.count == 0);
+  for (int x = 0; x < 64; x += 8)
+    blit_damage_add(&damage, x, 0, 8, 8);
+  assert(damage.count == 1);
+  assert(damage.rects[0].x == 0 && damage.rects[0].x_extent == 64 && damage.rects[0].y_extent == 8);
+  blit_damage_add(&damage, 0, 8, 64, 8);
+  assert(damage.count == 1 && damage.rects[0].y_extent == 16);
+  blit_damage_add(&damage, 10, 2, 5, 5);
+  assert(damage.count == 1);
+  for (int i = 0; i < BLIT_DAMAGE_RECT_MAX; i++)
+    blit_damage_add(&damage, 100 + 10 * i, 100 + 10 * i, 5, 5);
+  assert(damage.count == 1);
+  if (!blit_damage_bounds(&damage, &bounds))
+    return EXIT_FAILURE;
+  assert(bounds.x == 0 && bounds.y == 0 && bounds.x_extent == 100 + 10 * (BLIT_DAMAGE_RECT_MAX - 1) + 5);
+
+  /*
+   * Every pixel that any raster operation changes lies inside the damage.
+   */
+  BLIT_SCAN_DEFINE_STATIC(image, 300, 200);
+  BLIT_SCAN_DEFINE_STATIC(before, 300, 200);
+  BLIT_SCAN_DEFINE_STATIC(source, 300, 200);
+  BLIT_SCAN_DEFINE(pattern, 8, 8);
+  const size_t size = (size_t)(image.stride * image.height);
+  const struct blit_brush brush = {&pattern, 3, 5};
+  unsigned int seed = 17U;
+  for (size_t j = 0; j < size; j++)
+    source.store[j] = (blit_scanline_t)lcg(&seed);
+  for (size_t j = 0; j < sizeof(pattern_store); j++)
+    pattern.store[j] = (blit_scanline_t)lcg(&seed);
+  image.damage = &damage;
+
+  for (int i = 0; i < 300; i++) {
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = (blit_scanline_t)lcg(&seed);
+    (void)memcpy(before.store, image.store, size);
+    blit_damage_clear(&damage);
+    for (int k = 0; k < 4; k++) {
+      const int x = (int)(lcg(&seed) % 340U) - 20, y = (int)(lcg(&seed) % 240U) - 20;
+      const int x_extent = (int)(lcg(&seed) % 120U), y_extent = (int)(lcg(&seed) % 80U);
+      switch (lcg(&seed) % 5U) {
+      case 0:
+        (void)blit_rop2(&image, x, y, x_extent, y_extent, &source, x / 2, y / 2, (enum blit_rop2)(lcg(&seed) % 16U));
+        break;
+      case 1:
+        (void)blit_rop1(&image, x, y, x_extent, y_extent, (enum blit_rop1)(lcg(&seed) % 4U));
+        break;
+      case 2:
+        (void)blit_rop3(&image, x, y, x_extent, y_extent, &source, x / 2, y / 2, &brush, (enum blit_rop3)(lcg(&seed) % 256U));
+        break;
+      case 3:
+        (void)blit_tile(&image, x, y, x_extent, y_extent, &pattern, 0, 0, (enum blit_rop2)(lcg(&seed) % 16U));
+        break;
+      default:
+        (void)blit_scroll(&image, x, y, x_extent, y_extent, (int)(lcg(&seed) % 21U) - 10, (int)(lcg(&seed) % 21U) - 10, true);
+      }
+    }
+    for (int v = 0; v < image.height; v++)
+      for (int u = 0; u < image.width; u++)
+        if (bit_get(&before, u, v) != bit_get(&image, u, v) && !damaged(&damage, u, v)) {
+          (void)printf("undamaged change at %d,%d\n", u, v);
+          return EXIT_FAILURE;
+        }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,92 @@
+#include <blit/depth.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+static unsigned int rop2_pixel(enum blit_rop2 rop2, unsigned int s, unsigned int d, int depth) {
+  unsigned int pixel = 0U;
+  for (int bit = 0; bit < depth; bit++)
+    pixel |= ((rop2 >> (2 * ((s >> bit) & 1) + ((d >> bit) & 1))) & 1U) << bit;
+  return pixel;
+}
+
+int test_depth() {
+  BLIT_SCAN_DEFINE_DEPTH_STATIC(image, 150, 8, 4);
+  BLIT_SCAN_DEFINE_DEPTH_STATIC(expected, 150, 8, 4);
+  BLIT_SCAN_DEFINE_DEPTH_STATIC(source, 140, 9, 4);
+  const size_t size = sizeof(image_store);
+  unsigned int seed = 23U;
+
+  /*
+   * Random 2- and 4-bit blits and fills, partly off the scans, against a
+   * pixel-by-pixel reference. The scans hold 150 4-bit or 300 2-bit pixels
+   * across.
+   */
+  for (int i = 0; i < 1200; i++) {
+    const int depth = (i & 1) ? 4 : 2;
+    const int width = image.width / depth, width_source = source.width / depth;
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = expected.store[j] = (blit_scanline_t)lcg(&seed);
+    for (size_t j = 0; j < sizeof(source_store); j++)
+      source.store[j] = (blit_scanline_t)lcg(&seed);
+
+    const enum blit_rop2 rop2 = (enum blit_rop2)(lcg(&seed) & 15U);
+    const bool fill = (i & 2) != 0;
+    const unsigned int pixel = lcg(&seed) & ((1U << depth) - 1U);
+    const int x_extent = 1 + (int)(lcg(&seed) % (unsigned int)width), y_extent = 1 + (int)(lcg(&seed) % 8U);
+    const int x = (int)(lcg(&seed) % (unsigned int)width) - 10, y = (int)(lcg(&seed) % 8U) - 1;
+    const int x_source = (int)(lcg(&seed) % (unsigned int)width_source) - 10, y_source = (int)(lcg(&seed) % 9U) - 1;
+
+    if (fill)
+      (void)blit_fill_depth(&image, x, y, x_extent, y_extent, depth, pixel, rop2);
+    else
+      (void)blit_rop2_depth(&image, x, y, x_extent, y_extent, &source, x_source, y_source, depth, rop2);
+    for (int v = 0; v < image.height; v++) {
+      for (int u = 0; u < width; u++) {
+        const int u_source = u - x + x_source, v_source = v - y + y_source;
+        if (u < x || u >= x + x_extent || v < y || v >= y + y_extent)
+          continue;
+        if (!fill && (u_source < 0 || u_source >= width_source || v_source < 0 || v_source >= source.height))
+          continue;
+        const unsigned int s = fill ? pixel : blit_depth_pixel(&source, u_source, v_source, depth);
+        blit_depth_set_pixel(&expected, u, v, depth, rop2_pixel(rop2, s, blit_depth_pixel(&expected, u, v, depth), depth));
+      }
+    }
+    if (memcmp(expected.store, image.store, size) != 0) {
+      (void)printf("depth=%d fill=%d rop2=%d x=%d y=%d x_extent=%d y_extent=%d x_source=%d y_source=%d\n", depth, fill, rop2, x, y, x_extent, y_extent,
+                   x_source, y_source);
+      return EXIT_FAILURE;
+    }
+  }
+
+  /*
+   * Clipped regions come back in pixels.
+   */
+  struct blit_rgn1 x_rgn1 = {.origin = -3, .extent = 10, .origin_source = 0};
+  struct blit_rgn1 y_rgn1 = {.origin = 0, .extent = 1, .origin_source = 0};
+  if (blit_rgn1_rop2_depth(&image, &x_rgn1, &y_rgn1, &source, 2, blit_rop2_copy) <= 0)
+    return EXIT_FAILURE;
+  assert(x_rgn1.origin == 0 && x_rgn1.extent == 7 && x_rgn1.origin_source == 3);
+
+  /*
+   * Unsupported depths do nothing.
+   */
+  static const int bad_depths[] = {0, 3, 5, 9, 16, 31, 32, 64};
+  for (size_t i = 0; i < sizeof(bad_depths) / sizeof(bad_depths[0]); i++) {
+    const int depth = bad_depths[i];
+    (void)memcpy(expected.store, image.store, size);
+    struct blit_rgn1 x_bad = {.origin = 0, .extent = 4, .origin_source = 0};
+    struct blit_rgn1 y_bad = {.origin = 0, .extent = 1, .origin_source = 0};
+    if (blit_rgn1_rop2_depth(&image, &x_bad, &y_bad, &source, depth, blit_rop2_copy) != 0 ||
+        blit_rop2_depth(&image, 0, 0, 4, 1, &source, 0, 0, depth, blit_rop2_copy) != 0 ||
+        blit_fill_depth(&image, 0, 0, 4, 1, depth, 1U, blit_rop2_S) != 0 || memcmp(expected.store, image.store, size) != 0)
+      return EXIT_FAILURE;
+    assert(x_bad.origin == 0 && x_bad.extent == 4 && x_bad.origin_source == 0);
+  }
+
+  return EXIT_SUCCESS;
+}
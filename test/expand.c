@@ -0,0 +1,100 @@
+#include <blit/expand.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+static uint32_t pixel_get(const struct blit_chunky *chunky, int x, int y) {
+  const uint8_t *store = (const uint8_t *)chunky->store + chunky->stride * y + (chunky->depth >> 3) * x;
+  uint8_t pixel8;
+  uint16_t pixel16;
+  uint32_t pixel32;
+  switch (chunky->depth) {
+  case 8:
+    (void)memcpy(&pixel8, store, sizeof(pixel8));
+    return pixel8;
+  case 16:
+    (void)memcpy(&pixel16, store, sizeof(pixel16));
+    return pixel16;
+  default:
+    (void)memcpy(&pixel32, store, sizeof(pixel32));
+    return pixel32;
+  }
+}
+
+int test_expand() {
+  BLIT_SCAN_DEFINE_STATIC(source, 3000, 8);
+  static uint32_t store[6][2500], before[6][2500];
+  unsigned int seed = 19U;
+
+  for (size_t j = 0; j < sizeof(source_store); j++)
+    source.store[j] = (blit_scanline_t)lcg(&seed);
+
+  /*
+   * Random regions at every depth, opaque and transparent, partly off both
+   * buffers and wider than one chunk. Check every pixel.
+   */
+  for (int i = 0; i < 900; i++) {
+    const int depth = 8 << (i % 3);
+    struct blit_chunky chunky = {store, 2500 * 4 / (depth >> 3), 6, 2500 * 4, depth};
+    for (int v = 0; v < 6; v++)
+      for (int u = 0; u < 2500; u++)
+        store[v][u] = before[v][u] = (uint32_t)lcg(&seed) << 16 | lcg(&seed);
+
+    const bool transparent = (i & 4) != 0;
+    const uint32_t foreground = (uint32_t)lcg(&seed) << 16 | lcg(&seed), background = (uint32_t)lcg(&seed) << 16 | lcg(&seed);
+    const uint32_t pixel_mask = depth == 32 ? 0xffffffffU : (1U << depth) - 1U;
+    const int x_extent = 1 + (int)(lcg(&seed) % ((i & 8) ? 2900U : 70U)), y_extent = 1 + (int)(lcg(&seed) % 6U);
+    const int x = (int)(lcg(&seed) % (unsigned int)chunky.width) - 30, y = (int)(lcg(&seed) % 6U) - 1;
+    const int x_source = (int)(lcg(&seed) % 3000U) - 30, y_source = (int)(lcg(&seed) % 8U) - 1;
+
+    (void)blit_expand(&chunky, x, y, x_extent, y_extent, &source, x_source, y_source, foreground, background, transparent);
+    const struct blit_chunky expected = {before, chunky.width, 6, chunky.stride, depth};
+    for (int v = 0; v < 6; v++) {
+      for (int u = 0; u < chunky.width; u++) {
+        uint32_t pixel = pixel_get(&expected, u, v);
+        const int u_source = u - x + x_source, v_source = v - y + y_source;
+        if (u >= x && u < x + x_extent && v >= y && v < y + y_extent && u_source >= 0 && u_source < source.width && v_source >= 0 &&
+            v_source < source.height) {
+          if (bit_get(&source, u_source, v_source))
+            pixel = foreground & pixel_mask;
+          else if (!transparent)
+            pixel = background & pixel_mask;
+        }
+        if (pixel != pixel_get(&chunky, u, v)) {
+          (void)printf("depth=%d x=%d y=%d x_extent=%d y_extent=%d x_source=%d y_source=%d at %d,%d\n", depth, x, y, x_extent, y_extent, x_source, y_source, u,
+                       v);
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  /*
+   * A glyph row into RGB565.
+   */
+  BLIT_SCAN_DEFINE(glyph, 8, 1);
+  uint16_t row[10] = {0};
+  struct blit_chunky rgb565 = {row, 10, 1, sizeof(row), 16};
+  glyph.store[0] = 0xa5U;
+  if (blit_expand(&rgb565, 1, 0, 8, 1, &glyph, 0, 0, 0xf800U, 0x001fU, false) != 8)
+    return EXIT_FAILURE;
+  assert(row[0] == 0U && row[1] == 0xf800U && row[2] == 0x001fU && row[3] == 0xf800U && row[8] == 0xf800U && row[9] == 0U);
+
+  /*
+   * Depths other than 8, 16 and 32 expand nothing.
+   */
+  static const int bad_depths[] = {0, 4, 24, 33, 64};
+  uint16_t unchanged[10];
+  (void)memcpy(unchanged, row, sizeof(row));
+  for (size_t i = 0; i < sizeof(bad_depths) / sizeof(bad_depths[0]); i++) {
+    struct blit_chunky bad = {row, 10, 1, sizeof(row), bad_depths[i]};
+    if (blit_expand(&bad, 0, 0, 10, 1, &glyph, 0, 0, 0xffffU, 0U, false) != 0 || memcmp(unchanged, row, sizeof(row)) != 0)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,38 @@
+/*
+ * SPDX-FileCopyrightText: 2025, Roy Ratcliffe, Northumberland, United Kingdom
+ * SPDX-License-Identifier: MIT
+ */
+/*!
+ * \file fixture.h
+ * \brief Test fixtures.
+ * \details This header file defines the helpers that the tests share: a
+ * linear congruential generator for repeatable noise, and reference bit
+ * accessors. The accessors walk a scan one bit at a time, so they share
+ * nothing with the library's byte and word paths.
+ */
+
+#ifndef __TEST_FIXTURE_H__
+#define __TEST_FIXTURE_H__
+
+#include <blit/scan.h>
+
+/*!
+ * \brief Answers the next pseudo-random number, 0 through 65535.
+ * \param seed Pointer to the generator state.
+ */
+static inline unsigned int lcg(unsigned int *seed) { return (*seed = *seed * 1103515245U + 12345U) >> 16; }
+
+/*!
+ * \brief Answers the bit at a position in a scan.
+ */
+static inline int bit_get(const struct blit_scan *scan, int x, int y) { return (*blit_scan_find(scan, x, y) >> (7 - (x & 7))) & 1; }
+
+/*!
+ * \brief Stores a bit at a position in a scan.
+ */
+static inline void bit_put(struct blit_scan *scan, int x, int y, int bit) {
+  blit_scanline_t *store = blit_scan_find(scan, x, y);
+  *store = (blit_scanline_t)(bit ? *store | (0x80U >> (x & 7)) : *store & ~(0x80U >> (x & 7)));
+}
+
+#endif /* __TEST_FIXTURE_H__ */
@@ -0,0 +1,86 @@
+#include <blit/mask.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+static bool inside(const struct blit_scan *scan, int x, int y) { return x >= 0 && x < scan->width && y >= 0 && y < scan->height; }
+
+int test_mask() {
+  BLIT_SCAN_DEFINE_STATIC(image, 2200, 10);
+  BLIT_SCAN_DEFINE_STATIC(expected, 2200, 10);
+  BLIT_SCAN_DEFINE_STATIC(source, 2100, 12);
+  BLIT_SCAN_DEFINE_STATIC(mask, 2150, 11);
+  const size_t size = (size_t)(image.stride * image.height);
+  unsigned int seed = 13U;
+
+  for (size_t j = 0; j < sizeof(source_store); j++)
+    source.store[j] = (blit_scanline_t)lcg(&seed);
+
+  /*
+   * Random operations, rectangles and mask origins, partly off every scan and
+   * with the source sometimes the destination itself. Widths run past one
+   * chunk. Check every bit: the operation where the mask is 1, the destination
+   * where it is 0, and nothing outside the intersection of all three scans.
+   */
+  for (int i = 0; i < 600; i++) {
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = expected.store[j] = (blit_scanline_t)lcg(&seed);
+    for (size_t j = 0; j < sizeof(mask_store); j++)
+      mask.store[j] = (blit_scanline_t)lcg(&seed);
+
+    const enum blit_rop2 rop2 = (enum blit_rop2)(i & 15);
+    const bool in_place = (i & 48) == 48;
+    const struct blit_scan *from = in_place ? &expected : &source;
+    const int x_extent = 1 + (int)(lcg(&seed) % ((i & 64) ? 2100U : 100U));
+    const int y_extent = 1 + (int)(lcg(&seed) % 10U);
+    const int x = (int)(lcg(&seed) % (unsigned int)(image.width - x_extent + 1)) - 20;
+    const int y = (int)(lcg(&seed) % (unsigned int)(image.height - y_extent + 1)) - 1;
+    const int x_source = (int)(lcg(&seed) % (unsigned int)(2100 - x_extent + 1)) - 10;
+    const int y_source = in_place ? y + (int)(lcg(&seed) % 3U) - 1 : (int)(lcg(&seed) % 4U) - 1;
+    const int x_mask = (int)(lcg(&seed) % (unsigned int)(2150 - x_extent + 1)) + (int)(lcg(&seed) % 40U) - 20;
+    const int y_mask = (int)(lcg(&seed) % 4U) - 1;
+
+    (void)blit_rop2_mask(&image, x, y, x_extent, y_extent, in_place ? &image : &source, x_source, y_source, &mask, x_mask, y_mask, rop2);
+    for (int v = 0; v < image.height; v++) {
+      for (int u = 0; u < image.width; u++) {
+        int bit = bit_get(&expected, u, v);
+        const int u_source = u - x + x_source, v_source = v - y + y_source;
+        const int u_mask = u - x + x_mask, v_mask = v - y + y_mask;
+        const bool uses_source = (rop2 >> 2) != (rop2 & 3);
+        if (u >= x && u < x + x_extent && v >= y && v < y + y_extent && (!uses_source || inside(from, u_source, v_source)) &&
+            inside(&mask, u_mask, v_mask) && bit_get(&mask, u_mask, v_mask)) {
+          const int s = uses_source ? bit_get(from, u_source, v_source) : 0;
+          bit = (rop2 >> (2 * s + bit)) & 1;
+        }
+        if (bit != bit_get(&image, u, v)) {
+          (void)printf("rop2=%d x=%d y=%d x_extent=%d y_extent=%d x_source=%d y_source=%d x_mask=%d y_mask=%d at %d,%d\n", rop2, x, y, x_extent, y_extent,
+                       x_source, y_source, x_mask, y_mask, u, v);
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  /*
+   * A transparent sprite in one pass, and a masked fill without a source.
+   */
+  BLIT_SCAN_DEFINE(screen, 16, 1);
+  BLIT_SCAN_DEFINE(sprite, 8, 1);
+  BLIT_SCAN_DEFINE(sprite_mask, 8, 1);
+  screen.store[0] = 0x00U;
+  screen.store[1] = 0x00U;
+  sprite.store[0] = 0x81U;
+  sprite_mask.store[0] = 0xc3U;
+  if (blit_rop2_mask(&screen, 4, 0, 8, 1, &sprite, 0, 0, &sprite_mask, 0, 0, blit_rop2_copy) != 2)
+    return EXIT_FAILURE;
+  assert(screen.store[0] == 0x08U && screen.store[1] == 0x10U);
+  if (blit_rop2_mask(&screen, 4, 0, 8, 1, NULL, 0, 0, &sprite_mask, 0, 0, blit_rop2_1) != 2)
+    return EXIT_FAILURE;
+  assert(screen.store[0] == 0x0cU && screen.store[1] == 0x30U);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+#include <blit/mirror.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+int test_mirror() {
+  BLIT_SCAN_DEFINE_STATIC(image, 2000, 40);
+  BLIT_SCAN_DEFINE_STATIC(expected, 2000, 40);
+  BLIT_SCAN_DEFINE_STATIC(source, 1900, 44);
+  BLIT_SCAN_DEFINE_STATIC(wide, 80000, 2);
+  BLIT_SCAN_DEFINE_STATIC(wide_source, 80000, 2);
+  const size_t size = sizeof(image_store);
+  unsigned int seed = 37U;
+
+  for (size_t j = 0; j < sizeof(source_store); j++)
+    source.store[j] = (blit_scanline_t)lcg(&seed);
+
+  /*
+   * Random regions and operations, partly off both scans, sometimes in place.
+   * Check every bit against the mirror image of a snapshot.
+   */
+  for (int i = 0; i < 800; i++) {
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = expected.store[j] = (blit_scanline_t)lcg(&seed);
+
+    const enum blit_rop2 rop2 = (enum blit_rop2)(i & 15);
+    const bool in_place = (i & 48) == 48;
+    const struct blit_scan *from = in_place ? &expected : &source;
+    const int x_extent = 1 + (int)(lcg(&seed) % ((i & 64) ? 1900U : 90U)), y_extent = 1 + (int)(lcg(&seed) % 40U);
+    const int x = (int)(lcg(&seed) % 2000U) - 40, y = (int)(lcg(&seed) % 40U) - 3;
+    const int x_source = (int)(lcg(&seed) % 1900U) - 40;
+    const int y_source = in_place ? y + (int)(lcg(&seed) % 9U) - 4 : (int)(lcg(&seed) % 44U) - 3;
+
+    (void)blit_rop2_mirror(&image, x, y, x_extent, y_extent, in_place ? &image : &source, x_source, y_source, rop2);
+    for (int v = 0; v < image.height; v++) {
+      for (int u = 0; u < image.width; u++) {
+        int bit = bit_get(&expected, u, v);
+        const int u_source = x_source + x_extent - 1 - (u - x), v_source = v - y + y_source;
+        if (u >= x && u < x + x_extent && v >= y && v < y + y_extent && u_source >= 0 && u_source < from->width && v_source >= 0 &&
+            v_source < from->height)
+          bit = (rop2 >> (2 * bit_get(from, u_source, v_source) + bit)) & 1;
+        if (bit != bit_get(&image, u, v)) {
+          (void)printf("rop2=%d x=%d y=%d x_extent=%d y_extent=%d x_source=%d y_source=%d at %d,%d\n", rop2, x, y, x_extent, y_extent, x_source, y_source, u,
+                       v);
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  /*
+   * Scanlines wider than the stage go in column chunks.
+   */
+  for (size_t j = 0; j < sizeof(wide_source_store); j++)
+    wide_source.store[j] = (blit_scanline_t)lcg(&seed);
+  if (blit_rop2_mirror(&wide, 3, 0, 79990, 2, &wide_source, 5, 0, blit_rop2_copy) <= 0)
+    return EXIT_FAILURE;
+  for (int v = 0; v < 2; v++)
+    for (int u = 3; u < 79993; u++)
+      if (bit_get(&wide, u, v) != bit_get(&wide_source, 5 + 79990 - 1 - (u - 3), v))
+        return EXIT_FAILURE;
+
+  /*
+   * In place, such scanlines mirror onto other rows and onto themselves, the
+   * latter shifted either way or not at all.
+   */
+  if (blit_rop2_mirror(&wide, 0, 1, 79990, 1, &wide, 5, 0, blit_rop2_copy) <= 0)
+    return EXIT_FAILURE;
+  for (int u = 0; u < 79990; u++)
+    if (bit_get(&wide, u, 1) != bit_get(&wide, 5 + 79990 - 1 - u, 0))
+      return EXIT_FAILURE;
+  static const int shifts[][2] = {{0, 5}, {5, 0}, {3, 3}, {0, 40000}};
+  for (size_t i = 0; i < sizeof(shifts) / sizeof(shifts[0]); i++) {
+    const int x = shifts[i][0], x_source = shifts[i][1], extent = 79990 - x_source;
+    (void)memcpy(wide_source.store, wide.store, sizeof(wide_store));
+    if (blit_rop2_mirror(&wide, x, 0, extent, 2, &wide, x_source, 0, blit_rop2_copy) != 2 * (((x + extent - 1) >> 3) - (x >> 3) + 1))
+      return EXIT_FAILURE;
+    for (int v = 0; v < 2; v++)
+      for (int u = 0; u < 80000; u++)
+        if (bit_get(&wide, u, v) != (u >= x && u < x + extent ? bit_get(&wide_source, x_source + extent - 1 - (u - x), v) : bit_get(&wide_source, u, v)))
+          return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+#include <blit/scroll.h>
+
+#include <assert.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+int test_overlap() {
+  BLIT_SCAN_DEFINE_STATIC(image, 200, 16);
+  BLIT_SCAN_DEFINE_STATIC(expected, 200, 16);
+  BLIT_SCAN_DEFINE_STATIC(temp, 200, 16);
+  const size_t size = (size_t)(image.stride * image.height);
+  unsigned int seed = 7U;
+
+  /*
+   * Blit a scan onto itself with overlapping regions in every direction. The
+   * expected result goes through a temporary copy of the source region, which
+   * cannot overlap.
+   */
+  for (int i = 0; i < 4000; i++) {
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = (blit_scanline_t)lcg(&seed);
+    (void)memcpy(expected.store, image.store, size);
+
+    const enum blit_rop2 rop2 = (enum blit_rop2)(i & 15);
+    const int x_extent = 1 + (int)(lcg(&seed) % 160U);
+    const int y_extent = 1 + (int)(lcg(&seed) % 12U);
+    const int x = (int)(lcg(&seed) % (unsigned int)(image.width - x_extent + 1));
+    const int y = (int)(lcg(&seed) % (unsigned int)(image.height - y_extent + 1));
+    const int x_source = (int)(lcg(&seed) % (unsigned int)(image.width - x_extent + 1));
+    const int y_source = (i & 16) ? y : (int)(lcg(&seed) % (unsigned int)(image.height - y_extent + 1));
+
+    const int temp_count = blit_rop2(&temp, 0, 0, x_extent, y_extent, &expected, x_source, y_source, blit_rop2_copy);
+    const int expected_count = blit_rop2(&expected, x, y, x_extent, y_extent, &temp, 0, 0, rop2);
+    const int count = blit_rop2(&image, x, y, x_extent, y_extent, &image, x_source, y_source, rop2);
+    if (temp_count == 0 || expected_count == 0 || count != expected_count || memcmp(expected.store, image.store, size) != 0) {
+      (void)printf("rop2=%d x=%d y=%d x_source=%d y_source=%d x_extent=%d y_extent=%d\n", rop2, x, y, x_source, y_source, x_extent, y_extent);
+      return EXIT_FAILURE;
+    }
+  }
+
+  /*
+   * Scroll rectangles in place and check every bit inside and around them.
+   */
+  for (int i = 0; i < 500; i++) {
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = (blit_scanline_t)lcg(&seed);
+    (void)memcpy(expected.store, image.store, size);
+
+    const int x_extent = 1 + (int)(lcg(&seed) % 160U);
+    const int y_extent = 1 + (int)(lcg(&seed) % 12U);
+    const int x = (int)(lcg(&seed) % (unsigned int)(image.width - x_extent + 1));
+    const int y = (int)(lcg(&seed) % (unsigned int)(image.height - y_extent + 1));
+    const int dx = (int)(lcg(&seed) % 41U) - 20;
+    const int dy = (int)(lcg(&seed) % 9U) - 4;
+    const bool fill = (i & 1) != 0;
+
+    (void)blit_scroll(&image, x, y, x_extent, y_extent, dx, dy, fill);
+    for (int v = 0; v < image.height; v++) {
+      for (int u = 0; u < image.width; u++) {
+        int bit = bit_get(&expected, u, v);
+        if (u >= x && u < x + x_extent && v >= y && v < y + y_extent) {
+          const int u_source = u - dx, v_source = v - dy;
+          const bool inside = u_source >= x && u_source < x + x_extent && v_source >= y && v_source < y + y_extent;
+          bit = inside ? bit_get(&expected, u_source, v_source) : fill;
+        }
+        if (bit != bit_get(&image, u, v)) {
+          (void)printf("x=%d y=%d x_extent=%d y_extent=%d dx=%d dy=%d at %d,%d\n", x, y, x_extent, y_extent, dx, dy, u, v);
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  /*
+   * Offsets at the limits of int expose the whole rectangle.
+   */
+  (void)memset(image.store, 0, size);
+  if (blit_scroll(&image, 8, 2, 16, 4, INT_MIN, 0, true) != 8 || blit_scroll(&image, 8, 2, 16, 4, 0, INT_MIN, false) != 8 ||
+      blit_scroll(&image, 8, 2, 16, 4, INT_MAX, INT_MIN, true) != 8)
+    return EXIT_FAILURE;
+  assert(image.store[2 * image.stride + 1] == 0xffU && image.store[5 * image.stride + 2] == 0xffU && image.store[2 * image.stride + 3] == 0x00U);
+
+  return EXIT_SUCCESS;
+}
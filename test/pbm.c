@@ -0,0 +1,84 @@
+#include <blit/pbm.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+int test_pbm() {
+  BLIT_SCAN_DEFINE_STATIC(image, 2500, 30);
+  static const char path[] = "test_pbm.pbm";
+  struct blit_scan scan;
+  struct blit_pbm_map map;
+  unsigned int seed = 29U;
+
+  /*
+   * Headers with comments and odd white space parse; truncated ones do not.
+   */
+  static const unsigned char data[] = "P4 # comment\n 9\t#\r2\n\xff\x80\x7f\x00";
+  if (!blit_pbm_parse(&scan, data, sizeof(data) - 1U))
+    return EXIT_FAILURE;
+  if (scan.width != 9 || scan.height != 2 || scan.stride != 2 || scan.store != data + sizeof(data) - 5U)
+    return EXIT_FAILURE;
+  if (blit_pbm_parse(&scan, data, sizeof(data) - 2U) || blit_pbm_parse(&scan, "P5 1 1\n\x00", 8U) || blit_pbm_parse(&scan, "P4 1 1", 6U))
+    return EXIT_FAILURE;
+
+  for (size_t j = 0; j < sizeof(image_store); j++)
+    image.store[j] = (blit_scanline_t)lcg(&seed);
+
+  /*
+   * Write random regions, partly off every edge, then map them back and
+   * compare every pixel.
+   */
+  for (int i = 0; i < 60; i++) {
+    const int x = (int)(lcg(&seed) % 2600U) - 50, y = (int)(lcg(&seed) % 40U) - 5;
+    const int x_extent = (int)(lcg(&seed) % 2600U), y_extent = (int)(lcg(&seed) % 40U);
+    FILE *file = fopen(path, "wb");
+    if (file == NULL)
+      return EXIT_FAILURE;
+    const bool wrote = blit_pbm_write(file, &image, x, y, x_extent, y_extent);
+    if (fclose(file) != 0 || !wrote)
+      return EXIT_FAILURE;
+
+    const int x0 = x > 0 ? x : 0, y0 = y > 0 ? y : 0;
+    const int x1 = x + x_extent < image.width ? x + x_extent : image.width, y1 = y + y_extent < image.height ? y + y_extent : image.height;
+    const bool empty = x0 >= x1 || y0 >= y1;
+    if (!blit_pbm_map(&map, path, (i & 1) != 0)) {
+      /*
+       * An empty image maps only if its header does.
+       */
+      if (!empty)
+        return EXIT_FAILURE;
+      continue;
+    }
+    if (map.scan.width != (empty ? 0 : x1 - x0) || map.scan.height != (empty ? 0 : y1 - y0))
+      return EXIT_FAILURE;
+    for (int v = 0; v < map.scan.height; v++)
+      for (int u = 0; u < map.scan.width; u++)
+        if (bit_get(&map.scan, u, v) != bit_get(&image, x0 + u, y0 + v))
+          return EXIT_FAILURE;
+
+    /*
+     * Copy-on-write scans take writes without touching the file.
+     */
+    const bool written = (i & 1) != 0 && map.scan.height > 0;
+    const blit_scanline_t byte = written ? map.scan.store[0] : 0U;
+    if (written)
+      map.scan.store[0] ^= 0xffU;
+    blit_pbm_unmap(&map);
+    assert(map.address == NULL);
+    if (written) {
+      if (!blit_pbm_map(&map, path, false))
+        return EXIT_FAILURE;
+      const bool untouched = map.scan.store[0] == byte;
+      blit_pbm_unmap(&map);
+      if (!untouched)
+        return EXIT_FAILURE;
+    }
+  }
+  (void)remove(path);
+
+  return EXIT_SUCCESS;
+}
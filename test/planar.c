@@ -0,0 +1,87 @@
+#include <blit/planar.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+int test_planar() {
+  BLIT_PLANAR_DEFINE_STATIC(image, 300, 12, 4);
+  BLIT_PLANAR_DEFINE_STATIC(source, 280, 14, 4);
+  BLIT_SCAN_DEFINE_STATIC(expected, 300, 12);
+  BLIT_SCAN_DEFINE_STATIC(mono, 280, 14);
+  static blit_scanline_t before[sizeof(image_store)];
+  unsigned int seed = 17U;
+
+  /*
+   * Random regions and per-plane operations, partly off the scans. Every
+   * plane must match a single-plane blit of the same plane, whether the source
+   * has four planes, one plane, or is the destination itself.
+   */
+  for (int i = 0; i < 1500; i++) {
+    for (size_t j = 0; j < sizeof(image_store); j++)
+      image.store[j] = (blit_scanline_t)lcg(&seed);
+    for (size_t j = 0; j < sizeof(source_store); j++)
+      source.store[j] = (blit_scanline_t)lcg(&seed);
+    (void)memcpy(mono.store, source.store, sizeof(mono_store));
+    (void)memcpy(before, image.store, sizeof(image_store));
+
+    enum blit_rop2 rop2[4];
+    for (int plane = 0; plane < 4; plane++)
+      rop2[plane] = (enum blit_rop2)(lcg(&seed) & 15U);
+    struct blit_planar from = source;
+    if (i % 3 == 1)
+      from.plane_count = 1;
+    const bool in_place = i % 3 == 2;
+    const int x_extent = (int)(lcg(&seed) % 200U) + 1, y_extent = (int)(lcg(&seed) % 10U) + 1;
+    const int x = (int)(lcg(&seed) % 300U) - 40, y = (int)(lcg(&seed) % 12U) - 2;
+    const int x_source = (int)(lcg(&seed) % 280U) - 40, y_source = (int)(lcg(&seed) % 14U) - 2;
+
+    const int logic_count = blit_planar_rop2(&image, x, y, x_extent, y_extent, in_place ? &image : &from, x_source, y_source, rop2);
+    int expected_count = 0;
+    for (int plane = 0; plane < 4; plane++) {
+      struct blit_scan before_plane = BLIT_SCAN_INIT(before + image.plane_stride * plane, image.width, image.height, image.stride);
+      (void)memcpy(expected.store, before_plane.store, sizeof(expected_store));
+      const struct blit_scan source_plane = in_place ? before_plane : (from.plane_count == 1 ? mono : blit_planar_plane(&source, plane));
+      expected_count += blit_rop2(&expected, x, y, x_extent, y_extent, &source_plane, x_source, y_source, rop2[plane]);
+      if (memcmp(expected.store, image.store + image.plane_stride * plane, sizeof(expected_store)) != 0) {
+        (void)printf("plane=%d rop2=%d x=%d y=%d x_extent=%d y_extent=%d x_source=%d y_source=%d\n", plane, rop2[plane], x, y, x_extent, y_extent, x_source,
+                     y_source);
+        return EXIT_FAILURE;
+      }
+    }
+    if (logic_count != expected_count)
+      return EXIT_FAILURE;
+  }
+
+  /*
+   * Interleaved planes: one scanline of each plane in turn.
+   */
+  BLIT_SCAN_DEFINE(interleaved_store, 16, 6);
+  struct blit_planar interleaved = {interleaved_store.store, 16, 2, 6, 2, 3, NULL};
+  const enum blit_rop2 fill[3] = {blit_rop2_1, blit_rop2_0, blit_rop2_1};
+  (void)memset(interleaved.store, 0x55, 12);
+  if (blit_planar_rop2(&interleaved, 4, 0, 8, 2, &interleaved, 0, 0, fill) != 12)
+    return EXIT_FAILURE;
+  for (int row = 0; row < 6; row++) {
+    const blit_scanline_t expected_byte[2] = {row % 3 == 1 ? 0x50U : 0x5fU, row % 3 == 1 ? 0x05U : 0xf5U};
+    if (interleaved.store[row * 2] != expected_byte[0] || interleaved.store[row * 2 + 1] != expected_byte[1])
+      return EXIT_FAILURE;
+  }
+
+  /*
+   * Bad plane counts transfer nothing.
+   */
+  struct blit_planar two = source;
+  two.plane_count = 2;
+  struct blit_planar many = image;
+  many.plane_count = BLIT_PLANAR_MAX + 1;
+  (void)memcpy(before, image.store, sizeof(image_store));
+  if (blit_planar_rop2(&image, 0, 0, 8, 1, &two, 0, 0, fill) != 0 || blit_planar_rop2(&many, 0, 0, 8, 1, &source, 0, 0, fill) != 0 ||
+      memcmp(before, image.store, sizeof(image_store)) != 0)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
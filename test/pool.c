@@ -0,0 +1,75 @@
+#include <blit/pool.h>
+#include <blit/rop2.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+static void count_job(void *context, int index) { ((int *)context)[index]++; }
+
+int test_pool() {
+  BLIT_SCAN_DEFINE_STATIC(image, 1000, 300);
+  BLIT_SCAN_DEFINE_STATIC(expected, 1000, 300);
+  BLIT_SCAN_DEFINE_STATIC(source, 1000, 300);
+  const size_t size = (size_t)(image.stride * image.height);
+  unsigned int seed = 13U;
+  static int runs[1000];
+
+  /*
+   * Without threads the pool fails to start and everything runs serially;
+   * the comparisons below still hold.
+   */
+  if (!blit_pool_start(3)) {
+    (void)printf("pool unavailable\n");
+    assert(blit_pool_thread_count() == 0);
+  } else {
+    assert(blit_pool_thread_count() == 3);
+    if (blit_pool_start(3))
+      return EXIT_FAILURE;
+  }
+  blit_pool_set_threshold(1);
+
+  /*
+   * Every job runs exactly once.
+   */
+  blit_pool_run(&count_job, runs, 1000);
+  for (int i = 0; i < 1000; i++)
+    assert(runs[i] == 1);
+
+  /*
+   * Parallel blits, including in-place ones that must stay serial, against
+   * the same blits with the pool's threshold out of reach.
+   */
+  for (size_t j = 0; j < size; j++)
+    source.store[j] = (blit_scanline_t)lcg(&seed);
+  for (int i = 0; i < 300; i++) {
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = expected.store[j] = (blit_scanline_t)lcg(&seed);
+
+    const enum blit_rop2 rop2 = (enum blit_rop2)(i & 15);
+    const int x_extent = 1 + (int)(lcg(&seed) % 1000U);
+    const int y_extent = 1 + (int)(lcg(&seed) % 300U);
+    const int x = (int)(lcg(&seed) % (unsigned int)(1000 - x_extent + 1));
+    const int y = (int)(lcg(&seed) % (unsigned int)(300 - y_extent + 1));
+    const int x_source = (int)(lcg(&seed) % (unsigned int)(1000 - x_extent + 1));
+    const int y_source = (int)(lcg(&seed) % (unsigned int)(300 - y_extent + 1));
+    const bool in_place = (i & 16) != 0;
+
+    blit_pool_set_threshold(1);
+    const int logic_count = blit_rop2(&image, x, y, x_extent, y_extent, in_place ? &image : &source, x_source, y_source, rop2);
+    blit_pool_set_threshold(0x7fffffff);
+    const int expected_logic_count = blit_rop2(&expected, x, y, x_extent, y_extent, in_place ? &expected : &source, x_source, y_source, rop2);
+    if (logic_count != expected_logic_count || memcmp(expected.store, image.store, size) != 0) {
+      (void)printf("rop2=%d x=%d y=%d x_extent=%d y_extent=%d\n", rop2, x, y, x_extent, y_extent);
+      return EXIT_FAILURE;
+    }
+  }
+
+  blit_pool_stop();
+  assert(blit_pool_thread_count() == 0);
+  blit_pool_set_threshold(BLIT_POOL_THRESHOLD_DEFAULT);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+#include <blit/rle.h>
+#include <blit/rop1.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+int test_rle() {
+  BLIT_SCAN_DEFINE_STATIC(page, 421, 50);
+  BLIT_SCAN_DEFINE_STATIC(decoded, 421, 50);
+  BLIT_SCAN_DEFINE_STATIC(image, 400, 60);
+  BLIT_SCAN_DEFINE_STATIC(expected, 400, 60);
+  static uint16_t span[2 * 8000];
+  static uint32_t row[51];
+  struct blit_rle rle = {.span = span, .row = row, .span_max = 0U};
+  const size_t size = sizeof(image_store);
+  unsigned int seed = 3U;
+
+  /*
+   * A mostly clear page: random rectangles, some of them set, some random
+   * noise, and set padding bits past the width that must not show.
+   */
+  (void)memset(page.store, 0, sizeof(page_store));
+  for (int i = 0; i < 60; i++)
+    (void)blit_rop1(&page, (int)(lcg(&seed) % 421U), (int)(lcg(&seed) % 50U), (int)(lcg(&seed) % 120U), (int)(lcg(&seed) % 9U),
+                    i % 5 == 0 ? blit_rop1_Dn : blit_rop1_1);
+  for (int i = 0; i < 200; i++)
+    page.store[lcg(&seed) % sizeof(page_store)] ^= (blit_scanline_t)lcg(&seed);
+  for (int v = 0; v < page.height; v++)
+    *blit_scan_find(&page, 420, v) |= 0x7fU;
+
+  /*
+   * Size, fail to encode into too few spans, then encode and decode.
+   */
+  const size_t count = blit_rle_encode(&rle, &page);
+  assert(count > 0U && count <= 8000U);
+  (void)memset(decoded.store, 0xa5, sizeof(decoded_store));
+  rle.span_max = count - 1U;
+  if (blit_rle_encode(&rle, &page) != count || rle.width != 0 || rle.height != 0 || row[0] != 0U)
+    return EXIT_FAILURE;
+  blit_rle_decode(&rle, &decoded);
+  for (size_t j = 0; j < sizeof(decoded_store); j++)
+    if (decoded.store[j] != 0xa5U)
+      return EXIT_FAILURE;
+  rle.span_max = 8000U;
+  if (blit_rle_encode(&rle, &page) != count)
+    return EXIT_FAILURE;
+  for (size_t i = 0; i < count; i++)
+    assert(span[2 * i] < span[2 * i + 1] && span[2 * i + 1] <= 421U);
+  (void)memset(decoded.store, 0xa5, sizeof(decoded_store));
+  blit_rle_decode(&rle, &decoded);
+  for (int v = 0; v < page.height; v++) {
+    const blit_scanline_t *p = blit_scan_find(&page, 0, v), *d = blit_scan_find(&decoded, 0, v);
+    if (memcmp(p, d, 52) != 0 || (p[52] & 0x80U) != (d[52] & 0x80U))
+      return EXIT_FAILURE;
+  }
+
+  /*
+   * Compressed blits against plain blits from the page, for every operation,
+   * partly off every edge.
+   */
+  for (int i = 0; i < 3000; i++) {
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = expected.store[j] = (blit_scanline_t)lcg(&seed);
+
+    const enum blit_rop2 rop2 = (enum blit_rop2)(i & 15);
+    const int x_extent = (int)(lcg(&seed) % 480U) - 20, y_extent = (int)(lcg(&seed) % 70U) - 5;
+    const int x = (int)(lcg(&seed) % 440U) - 20, y = (int)(lcg(&seed) % 70U) - 5;
+    const int x_source = (int)(lcg(&seed) % 460U) - 20, y_source = (int)(lcg(&seed) % 60U) - 5;
+
+    (void)blit_rop2(&expected, x, y, x_extent, y_extent, &page, x_source, y_source, rop2);
+    (void)blit_rop2_rle(&image, x, y, x_extent, y_extent, &rle, x_source, y_source, rop2);
+    if (memcmp(image.store, expected.store, size) != 0) {
+      (void)printf("rop2=%d x=%d y=%d x_extent=%d y_extent=%d x_source=%d y_source=%d\n", rop2, x, y, x_extent, y_extent, x_source, y_source);
+      return EXIT_FAILURE;
+    }
+  }
+
+  /*
+   * Too wide for 16-bit spans: nothing encodes.
+   */
+  BLIT_SCAN_DEFINE_STATIC(wide, 70000, 1);
+  if (blit_rle_encode(&rle, &wide) != 0U || rle.width != 0 || rle.height != 0)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,69 @@
+#include <blit/rop1.h>
+#include <blit/rop2.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+int test_rop1() {
+  BLIT_SCAN_DEFINE_STATIC(image, 300, 12);
+  BLIT_SCAN_DEFINE_STATIC(expected, 300, 12);
+  BLIT_SCAN_DEFINE_STATIC(source, 8, 8);
+  const size_t size = (size_t)(image.stride * image.height);
+  unsigned int seed = 3U;
+
+  /*
+   * Clear, invert, leave and set random rectangles, some reaching off the
+   * scan, and check every bit against the truth table.
+   */
+  for (int i = 0; i < 2000; i++) {
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = expected.store[j] = (blit_scanline_t)lcg(&seed);
+
+    const enum blit_rop1 rop1 = (enum blit_rop1)(i & 3);
+    const int x = (int)(lcg(&seed) % 320U) - 10;
+    const int y = (int)(lcg(&seed) % 16U) - 2;
+    const int x_extent = (int)(lcg(&seed) % 300U);
+    const int y_extent = (int)(lcg(&seed) % 14U);
+
+    const int logic_count = blit_rop1(&image, x, y, x_extent, y_extent, rop1);
+    int expected_count = 0;
+    for (int v = 0; v < image.height; v++) {
+      int first = -1, last = -1;
+      for (int u = 0; u < image.width; u++) {
+        int bit = bit_get(&expected, u, v);
+        if (u >= x && u < x + x_extent && v >= y && v < y + y_extent) {
+          bit = (rop1 >> bit) & 1;
+          if (first < 0)
+            first = u;
+          last = u;
+        }
+        if (bit != bit_get(&image, u, v)) {
+          (void)printf("rop1=%d x=%d y=%d x_extent=%d y_extent=%d at %d,%d\n", rop1, x, y, x_extent, y_extent, u, v);
+          return EXIT_FAILURE;
+        }
+      }
+      if (first >= 0)
+        expected_count += (last >> 3) - (first >> 3) + 1;
+    }
+    if (logic_count != expected_count)
+      return EXIT_FAILURE;
+
+    /*
+     * The binary operations that ignore their source take the same path, but
+     * still clip against the source.
+     */
+    (void)memcpy(expected.store, image.store, size);
+    const enum blit_rop2 rop2 = (enum blit_rop2)(rop1 | rop1 << 2);
+    const int count = blit_rop2(&image, x, y, x_extent, y_extent, &image, x, y, rop2);
+    if (count != blit_rop1(&expected, x, y, x_extent, y_extent, rop1) || memcmp(expected.store, image.store, size) != 0)
+      return EXIT_FAILURE;
+    if (blit_rop2(&image, 0, 0, 300, 12, &source, 0, 0, rop2) != 8)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
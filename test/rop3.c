@@ -0,0 +1,98 @@
+#include <blit/rop3.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+static int mod(int a, int m) { return ((a % m) + m) % m; }
+
+int test_rop3() {
+  BLIT_SCAN_DEFINE_STATIC(image, 2200, 10);
+  BLIT_SCAN_DEFINE_STATIC(expected, 2200, 10);
+  BLIT_SCAN_DEFINE_STATIC(source, 2100, 12);
+  BLIT_SCAN_DEFINE_STATIC(pattern_store, 24, 16);
+  const size_t size = (size_t)(image.stride * image.height);
+  unsigned int seed = 11U;
+
+  for (size_t j = 0; j < sizeof(source_store); j++)
+    source.store[j] = (blit_scanline_t)lcg(&seed);
+
+  /*
+   * Random codes, rectangles, pattern sizes and brush origins, with the source
+   * sometimes the destination itself. Widths run past one chunk. Check every
+   * bit against the truth table.
+   */
+  for (int i = 0; i < 600; i++) {
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = expected.store[j] = (blit_scanline_t)lcg(&seed);
+    for (size_t j = 0; j < sizeof(pattern_store_store); j++)
+      pattern_store.store[j] = (blit_scanline_t)lcg(&seed);
+
+    const enum blit_rop3 rop3 = (enum blit_rop3)(i < 256 ? i : (int)(lcg(&seed) & 0xffU));
+    struct blit_scan pattern = pattern_store;
+    pattern.width = (i & 1) ? 8 : 1 + (int)(lcg(&seed) % 24U);
+    pattern.height = (i & 1) ? 8 : 1 + (int)(lcg(&seed) % 16U);
+    const struct blit_brush brush = {&pattern, (int)(lcg(&seed) % 40U) - 20, (int)(lcg(&seed) % 40U) - 20};
+    const bool in_place = (i & 6) == 6;
+    const struct blit_scan *from = in_place ? &expected : &source;
+    const int x_extent = 1 + (int)(lcg(&seed) % ((i & 8) ? 2100U : 100U));
+    const int y_extent = 1 + (int)(lcg(&seed) % 10U);
+    const int x = (int)(lcg(&seed) % (unsigned int)(image.width - x_extent + 1));
+    const int y = (int)(lcg(&seed) % (unsigned int)(image.height - y_extent + 1));
+    const int x_source = (int)(lcg(&seed) % (unsigned int)(2100 - x_extent + 1));
+    int y_source = y + (int)(lcg(&seed) % 3U) - 1;
+    if (y_source < 0 || y_source + y_extent > from->height)
+      y_source = y;
+
+    const int logic_count = blit_rop3(&image, x, y, x_extent, y_extent, in_place ? &image : &source, x_source, y_source, &brush, rop3);
+    if (logic_count != y_extent * (((x + x_extent - 1) >> 3) - (x >> 3) + 1))
+      return EXIT_FAILURE;
+    for (int v = 0; v < image.height; v++) {
+      for (int u = 0; u < image.width; u++) {
+        int bit = bit_get(&expected, u, v);
+        if (u >= x && u < x + x_extent && v >= y && v < y + y_extent) {
+          const int s = bit_get(from, u - x + x_source, v - y + y_source);
+          const int p = bit_get(&pattern, mod(u - brush.x, pattern.width), mod(v - brush.y, pattern.height));
+          bit = (rop3 >> (4 * p + 2 * s + bit)) & 1;
+        }
+        if (bit != bit_get(&image, u, v)) {
+          (void)printf("rop3=%02x x=%d y=%d x_extent=%d y_extent=%d x_source=%d y_source=%d at %d,%d\n", rop3, x, y, x_extent, y_extent, x_source, y_source,
+                       u, v);
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  /*
+   * Codes that ignore the source take a null source.
+   */
+  BLIT_SCAN_DEFINE(checker, 2, 2);
+  checker.store[0] = 0x80U;
+  checker.store[1] = 0x40U;
+  const struct blit_brush brush = {&checker, 0, 0};
+  (void)memset(image.store, 0, size);
+  if (blit_rop3(&image, 0, 0, 16, 2, NULL, 0, 0, &brush, blit_rop3_pat_copy) != 4)
+    return EXIT_FAILURE;
+  assert(image.store[0] == 0xaaU && image.store[1] == 0xaaU);
+  assert(image.store[image.stride] == 0x55U && image.store[image.stride + 1] == 0x55U);
+
+  /*
+   * Codes that read an empty pattern do nothing.
+   */
+  struct blit_scan empty = checker;
+  empty.width = 0;
+  const struct blit_brush empty_brush = {&empty, 0, 0};
+  (void)memcpy(expected.store, image.store, size);
+  if (blit_rop3(&image, 0, 0, 16, 2, &source, 0, 0, &empty_brush, blit_rop3_pat_copy) != 0)
+    return EXIT_FAILURE;
+  empty.width = 2;
+  empty.height = 0;
+  if (blit_rop3(&image, 0, 0, 16, 2, &source, 0, 0, &empty_brush, (enum blit_rop3)0xe2) != 0 || memcmp(expected.store, image.store, size) != 0)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+#include <blit/rotate.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+int test_rotate() {
+  BLIT_SCAN_DEFINE_STATIC(image, 700, 600);
+  BLIT_SCAN_DEFINE_STATIC(expected, 700, 600);
+  BLIT_SCAN_DEFINE_STATIC(source, 640, 560);
+  const size_t size = sizeof(image_store);
+  unsigned int seed = 31U;
+
+  for (size_t j = 0; j < sizeof(source_store); j++)
+    source.store[j] = (blit_scanline_t)lcg(&seed);
+
+  /*
+   * Random rotations, rectangles and operations, partly off both scans, some
+   * wider than one band chunk. Map every source pixel to the destination by
+   * the turn's formula.
+   */
+  for (int i = 0; i < 400; i++) {
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = expected.store[j] = (blit_scanline_t)lcg(&seed);
+
+    const enum blit_rotate rotate = (enum blit_rotate)(i % 5);
+    const enum blit_rop2 rop2 = (enum blit_rop2)(lcg(&seed) & 15U);
+    const unsigned int limit = (i & 8) ? 640U : 40U;
+    const int w = 1 + (int)(lcg(&seed) % limit), h = 1 + (int)(lcg(&seed) % ((i & 16) ? 560U : 40U));
+    const int x = (int)(lcg(&seed) % 700U) - 20, y = (int)(lcg(&seed) % 600U) - 20;
+    const int x_source = (int)(lcg(&seed) % 640U) - 20, y_source = (int)(lcg(&seed) % 560U) - 20;
+
+    const bool swap = rotate == blit_rotate_90 || rotate == blit_rotate_270 || rotate == blit_rotate_transpose;
+    (void)blit_rotate(&image, x, y, swap ? h : w, swap ? w : h, &source, x_source, y_source, rotate, rop2);
+    for (int t = 0; t < h; t++) {
+      for (int s = 0; s < w; s++) {
+        int u = 0, v = 0;
+        switch (rotate) {
+        case blit_rotate_0:
+          u = s, v = t;
+          break;
+        case blit_rotate_90:
+          u = h - 1 - t, v = s;
+          break;
+        case blit_rotate_180:
+          u = w - 1 - s, v = h - 1 - t;
+          break;
+        case blit_rotate_270:
+          u = t, v = w - 1 - s;
+          break;
+        default:
+          u = t, v = s;
+        }
+        u += x, v += y;
+        if (x_source + s < 0 || x_source + s >= source.width || y_source + t < 0 || y_source + t >= source.height || u < 0 || u >= image.width || v < 0 ||
+            v >= image.height)
+          continue;
+        const int d = bit_get(&expected, u, v);
+        bit_put(&expected, u, v, (rop2 >> (2 * bit_get(&source, x_source + s, y_source + t) + d)) & 1);
+      }
+    }
+    if (memcmp(expected.store, image.store, size) != 0) {
+      (void)printf("rotate=%d rop2=%d x=%d y=%d x_source=%d y_source=%d w=%d h=%d\n", rotate, rop2, x, y, x_source, y_source, w, h);
+      return EXIT_FAILURE;
+    }
+  }
+
+  /*
+   * Column chunks sharing a destination byte count it once, as
+   * `blit_rop2()` does.
+   */
+  static const enum blit_rotate unswapped[] = {blit_rotate_0, blit_rotate_180};
+  for (size_t i = 0; i < sizeof(unswapped) / sizeof(unswapped[0]); i++) {
+    const int logic_count = blit_rotate(&image, 3, 0, 600, 8, &source, 0, 0, unswapped[i], blit_rop2_copy);
+    if (logic_count != blit_rop2(&expected, 3, 0, 600, 8, &source, 0, 0, blit_rop2_copy))
+      return EXIT_FAILURE;
+  }
+
+  /*
+   * A quarter turn of a 3×2 rectangle.
+   */
+  BLIT_SCAN_DEFINE(tiny, 8, 2);
+  BLIT_SCAN_DEFINE(turned, 8, 3);
+  tiny.store[0] = 0xc0U; // ##.
+  tiny.store[1] = 0x20U; // ..#
+  (void)memset(turned.store, 0, 3);
+  if (blit_rotate(&turned, 0, 0, 2, 3, &tiny, 0, 0, blit_rotate_90, blit_rop2_copy) != 3)
+    return EXIT_FAILURE;
+  assert(turned.store[0] == 0x40U && turned.store[1] == 0x40U && turned.store[2] == 0x80U);
+
+  /*
+   * Clipping a quarter turn reports the destination region and the top-left
+   * corner of the source rectangle that remains. The destination's first
+   * two columns fall off its left edge; they would have come from the
+   * source's bottom two rows.
+   */
+  struct blit_rgn1 x_rgn1 = {.origin = -2, .extent = 6, .origin_source = 10};
+  struct blit_rgn1 y_rgn1 = {.origin = 0, .extent = 4, .origin_source = 20};
+  if (blit_rgn1_rotate(&image, &x_rgn1, &y_rgn1, &source, blit_rotate_90, blit_rop2_copy) <= 0)
+    return EXIT_FAILURE;
+  assert(x_rgn1.origin == 0 && x_rgn1.extent == 4 && x_rgn1.origin_source == 10);
+  assert(y_rgn1.origin == 0 && y_rgn1.extent == 4 && y_rgn1.origin_source == 20);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,81 @@
+#include <blit/shift.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+int test_shift() {
+  BLIT_SCAN_DEFINE_STATIC(image, 320, 48);
+  BLIT_SCAN_DEFINE_STATIC(expected, 320, 48);
+  BLIT_SCAN_DEFINE_STATIC(sprite0, 37, 20);
+  BLIT_SCAN_DEFINE_STATIC(sprite1, 64, 16);
+  BLIT_SCAN_DEFINE_STATIC(sprite2, 13, 30);
+  BLIT_SCAN_DEFINE_STATIC(large, 300, 40);
+  struct blit_scan *const sprites[] = {&sprite0, &sprite1, &sprite2, &large};
+  static blit_scanline_t store[BLIT_SHIFT_SLOT_MAX * 160];
+  struct blit_shift_cache cache;
+  const size_t size = sizeof(image_store);
+  unsigned int seed = 5U;
+
+  for (int k = 0; k < 4; k++)
+    for (int j = 0; j < sprites[k]->stride * sprites[k]->height; j++)
+      sprites[k]->store[j] = (blit_scanline_t)lcg(&seed);
+  blit_shift_cache_start(&cache, store, sizeof(store));
+  if (blit_shift_cache_find(&cache, &large, 3) != NULL)
+    return EXIT_FAILURE;
+  if (blit_shift_cache_find(&cache, &sprite0, 0) != NULL || blit_shift_cache_find(&cache, &sprite0, 8) != NULL || cache.misses != 0UL)
+    return EXIT_FAILURE;
+
+  /*
+   * Random blits of random sprites at random places, partly clipped, against
+   * uncached blits. Three sprites at eight phases overflow the slots, so the
+   * cache evicts as it goes. Now and then a sprite changes, and the cache
+   * forgets it.
+   */
+  for (int i = 0; i < 4000; i++) {
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = expected.store[j] = (blit_scanline_t)lcg(&seed);
+    struct blit_scan *sprite = sprites[lcg(&seed) % 4U];
+    if (i % 97 == 0) {
+      sprite->store[lcg(&seed) % (unsigned int)(sprite->stride * sprite->height)] ^= 0x5aU;
+      blit_shift_cache_forget(&cache, sprite);
+    }
+
+    const enum blit_rop2 rop2 = (enum blit_rop2)(i & 15);
+    const int x_extent = (int)(lcg(&seed) % (unsigned int)(sprite->width + 8)) - 4;
+    const int y_extent = (int)(lcg(&seed) % (unsigned int)(sprite->height + 8)) - 4;
+    const int x = (int)(lcg(&seed) % 360U) - 20, y = (int)(lcg(&seed) % 60U) - 6;
+    const int x_source = (int)(lcg(&seed) % 16U) - 4, y_source = (int)(lcg(&seed) % 8U) - 2;
+
+    const int expected_count = blit_rop2(&expected, x, y, x_extent, y_extent, sprite, x_source, y_source, rop2);
+    const int count = blit_rop2_shifted(&image, x, y, x_extent, y_extent, sprite, x_source, y_source, &cache, rop2);
+    if ((count == 0) != (expected_count == 0) || memcmp(image.store, expected.store, size) != 0) {
+      (void)printf("rop2=%d x=%d y=%d x_extent=%d y_extent=%d x_source=%d y_source=%d\n", rop2, x, y, x_extent, y_extent, x_source, y_source);
+      return EXIT_FAILURE;
+    }
+  }
+  assert(cache.hits > 0UL && cache.misses > 24UL);
+
+  /*
+   * The least-recently-used copy goes first.
+   */
+  blit_shift_cache_start(&cache, store, sizeof(store));
+  for (int shift = 1; shift < 8; shift++)
+    if (blit_shift_cache_find(&cache, &sprite0, shift) == NULL)
+      return EXIT_FAILURE;
+  if (blit_shift_cache_find(&cache, &sprite1, 1) == NULL)
+    return EXIT_FAILURE;
+  if (blit_shift_cache_find(&cache, &sprite0, 1) == NULL || cache.hits != 1UL)
+    return EXIT_FAILURE;
+  if (blit_shift_cache_find(&cache, &sprite2, 1) == NULL || cache.misses != 9UL)
+    return EXIT_FAILURE;
+  if (blit_shift_cache_find(&cache, &sprite0, 1) == NULL || cache.hits != 2UL)
+    return EXIT_FAILURE;
+  if (blit_shift_cache_find(&cache, &sprite0, 2) == NULL || cache.misses != 10UL)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
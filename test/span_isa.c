@@ -0,0 +1,56 @@
+#include <blit/span.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+int test_span_isa() {
+  static blit_scanline_t source[512], expected[512], result[512];
+  const enum blit_span_isa selected = blit_span_isa_selected();
+  unsigned int seed = 1U;
+
+  assert(blit_span_isa_supported(blit_span_isa_portable));
+  assert(blit_span_isa_supported(selected));
+
+  /*
+   * Run every supported instruction set's kernels against the portable
+   * kernels. Offsets shift the span through every alignment of the widest
+   * vector; counts cover empty spans, whole vectors and ragged tails.
+   */
+  for (enum blit_span_isa isa = blit_span_isa_sse2; isa <= blit_span_isa_avx512; isa++) {
+    if (!blit_span_isa_supported(isa)) {
+      if (blit_span_isa_select(isa))
+        return EXIT_FAILURE;
+      (void)printf("isa %d unsupported\n", isa);
+      continue;
+    }
+    for (int i = 0; i < 2000; i++) {
+      const enum blit_rop2 rop2 = (enum blit_rop2)(i & 15);
+      const int shift = (int)(lcg(&seed) % 8U);
+      const int offset = (int)(lcg(&seed) % 64U);
+      const int count = (int)(lcg(&seed) % 400U);
+      for (int j = 0; j < 512; j++) {
+        source[j] = (blit_scanline_t)lcg(&seed);
+        expected[j] = result[j] = (blit_scanline_t)lcg(&seed);
+      }
+      if (!blit_span_isa_select(blit_span_isa_portable))
+        return EXIT_FAILURE;
+      (*blit_span_func(rop2))(expected + offset, source + offset, shift, count);
+      if (!blit_span_isa_select(isa))
+        return EXIT_FAILURE;
+      (*blit_span_func(rop2))(result + offset, source + offset, shift, count);
+      if (memcmp(expected, result, sizeof(result)) != 0) {
+        (void)printf("isa=%d rop2=%d shift=%d offset=%d count=%d\n", isa, rop2, shift, offset, count);
+        return EXIT_FAILURE;
+      }
+    }
+    (void)printf("isa %d passed\n", isa);
+  }
+
+  if (!blit_span_isa_select(selected))
+    return EXIT_FAILURE;
+  return EXIT_SUCCESS;
+}
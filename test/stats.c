@@ -0,0 +1,55 @@
+#include <blit/rop2.h>
+#include <blit/stats.h>
+
+#include <assert.h>
+#include <stdlib.h>
+
+int test_stats() {
+  BLIT_SCAN_DEFINE_STATIC(result, 64, 8);
+  BLIT_SCAN_DEFINE_STATIC(source, 64, 8);
+  struct blit_stats stats = {{0}};
+  struct blit_stats *previous = blit_stats_capture(&stats);
+
+  /*
+   * One phase-aligned copy 2 bytes wide, one right-shifting copy inside one
+   * byte, one rejected by moving, one rejected by clipping and one that
+   * ignores its source.
+   */
+  const int aligned = blit_rop2(&result, 4, 0, 12, 3, &source, 4, 0, blit_rop2_copy);
+  const int shifted = blit_rop2(&result, 1, 0, 3, 2, &source, 0, 0, blit_rop2_copy);
+  const int moved = blit_rop2(&result, -10, 0, 4, 2, &source, 0, 0, blit_rop2_copy);
+  const int clipped = blit_rop2(&result, 70, 0, 4, 2, &source, 0, 0, blit_rop2_copy);
+  (void)blit_rop2(&result, 0, 0, 64, 8, &source, 0, 0, blit_rop2_1);
+  (void)blit_stats_capture(previous);
+  if (aligned != 6 || shifted != 2 || moved != 0 || clipped != 0)
+    return EXIT_FAILURE;
+
+#ifdef BLIT_STATS
+  assert(stats.count[blit_stats_calls] == 5U);
+  assert(stats.count[blit_stats_rejected_move] == 1U);
+  assert(stats.count[blit_stats_rejected_clip] == 1U);
+  assert(stats.count[blit_stats_source_free] == 1U);
+  assert(stats.count[blit_stats_rows] == 5U);
+  assert(stats.count[blit_stats_edge_stores] == 8U);
+  assert(stats.count[blit_stats_interior_stores] == 0U);
+  assert(stats.count[blit_stats_phase_none] == 1U);
+  assert(stats.count[blit_stats_phase_right_shift] == 1U);
+  assert(stats.count[blit_stats_phase_left_shift] == 0U);
+
+  /*
+   * The global statistics include everything captured.
+   */
+  struct blit_stats global;
+  blit_stats_read(&global);
+  for (int i = 0; i < blit_stats_counter_max; i++)
+    assert(global.count[i] >= stats.count[i]);
+  blit_stats_reset();
+  blit_stats_read(&global);
+  assert(global.count[blit_stats_calls] == 0U);
+#else
+  for (int i = 0; i < blit_stats_counter_max; i++)
+    assert(stats.count[i] == 0U);
+#endif
+
+  return EXIT_SUCCESS;
+}
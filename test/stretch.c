@@ -0,0 +1,75 @@
+#include <blit/stretch.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+/*
+ * Source pixel offset for destination pixel offset u.
+ */
+static int map(int u, int scale) { return scale > 1 ? (u >= 0 ? u / scale : -((-u + scale - 1) / scale)) : scale < -1 ? u * -scale : u; }
+
+int test_stretch() {
+  BLIT_SCAN_DEFINE_STATIC(image, 4500, 24);
+  BLIT_SCAN_DEFINE_STATIC(expected, 4500, 24);
+  BLIT_SCAN_DEFINE_STATIC(source, 1200, 20);
+  static const int scales[] = {1, 2, 3, 4, 5, 8, 9, 13, -2, -3, -4, -7};
+  const size_t size = sizeof(image_store);
+  unsigned int seed = 29U;
+
+  for (size_t j = 0; j < sizeof(source_store); j++)
+    source.store[j] = (blit_scanline_t)lcg(&seed);
+
+  /*
+   * Random scales, regions and operations, partly off both scans, some wider
+   * than one column chunk. Check every bit.
+   */
+  for (int i = 0; i < 500; i++) {
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = expected.store[j] = (blit_scanline_t)lcg(&seed);
+
+    const enum blit_rop2 rop2 = (enum blit_rop2)(i & 15);
+    const int x_scale = scales[lcg(&seed) % 12U], y_scale = scales[lcg(&seed) % 12U];
+    const int x_extent = 1 + (int)(lcg(&seed) % ((i & 16) ? 4500U : 200U)), y_extent = 1 + (int)(lcg(&seed) % 24U);
+    const int x = (int)(lcg(&seed) % 4500U) - 100, y = (int)(lcg(&seed) % 24U) - 4;
+    const int x_source = (int)(lcg(&seed) % 1200U) - 30, y_source = (int)(lcg(&seed) % 20U) - 3;
+
+    (void)blit_stretch(&image, x, y, x_extent, y_extent, &source, x_source, y_source, x_scale, y_scale, rop2);
+    for (int v = 0; v < image.height; v++) {
+      for (int u = 0; u < image.width; u++) {
+        int bit = bit_get(&expected, u, v);
+        const int u_source = x_source + map(u - x, x_scale), v_source = y_source + map(v - y, y_scale);
+        if (u >= x && u < x + x_extent && v >= y && v < y + y_extent && u_source >= 0 && u_source < source.width && v_source >= 0 &&
+            v_source < source.height)
+          bit = (rop2 >> (2 * bit_get(&source, u_source, v_source) + bit)) & 1;
+        if (bit != bit_get(&image, u, v)) {
+          (void)printf("rop2=%d scale=%d,%d x=%d y=%d x_extent=%d y_extent=%d x_source=%d y_source=%d at %d,%d\n", rop2, x_scale, y_scale, x, y, x_extent,
+                       y_extent, x_source, y_source, u, v);
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  /*
+   * Column chunks sharing a destination byte count it once: at unit scale,
+   * as `blit_rop2()` counts the same transfer.
+   */
+  if (blit_stretch(&expected, 3, 0, 4400, 8, &image, 0, 0, 1, 1, blit_rop2_copy) != blit_rop2(&expected, 3, 0, 4400, 8, &image, 0, 0, blit_rop2_copy))
+    return EXIT_FAILURE;
+
+  /*
+   * Clipping reports the destination region and the source pixel it starts
+   * from, part way into a doubled pixel.
+   */
+  struct blit_rgn1 x_rgn1 = {.origin = -3, .extent = 10, .origin_source = 4};
+  struct blit_rgn1 y_rgn1 = {.origin = 0, .extent = 2, .origin_source = 0};
+  if (blit_rgn1_stretch(&image, &x_rgn1, &y_rgn1, &source, 2, 1, blit_rop2_copy) <= 0)
+    return EXIT_FAILURE;
+  assert(x_rgn1.origin == 0 && x_rgn1.extent == 7 && x_rgn1.origin_source == 5);
+
+  return EXIT_SUCCESS;
+}
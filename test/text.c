@@ -0,0 +1,91 @@
+#include <blit/damage.h>
+#include <blit/text.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+int test_text() {
+  BLIT_SCAN_DEFINE_STATIC(atlas, 1200, 40);
+  BLIT_SCAN_DEFINE_STATIC(image, 300, 60);
+  BLIT_SCAN_DEFINE_STATIC(expected, 300, 60);
+  static struct blit_glyph glyph[96];
+  static uint32_t shifted[96 * 40 * 8];
+  const size_t size = sizeof(image_store);
+  unsigned int seed = 11U;
+
+  /*
+   * Random glyphs at odd places in a random atlas: mostly narrow, some wider
+   * than the narrow path takes, some empty, some hanging off the atlas, with
+   * offsets either side of the pen.
+   */
+  for (size_t j = 0; j < sizeof(atlas_store); j++)
+    atlas.store[j] = (blit_scanline_t)lcg(&seed);
+  for (int index = 0; index < 96; index++) {
+    struct blit_glyph *g = glyph + index;
+    g->width = index % 13 == 0 ? 0 : index % 7 == 0 ? BLIT_TEXT_NARROW + 1 + (int)(lcg(&seed) % 20U) : 1 + (int)(lcg(&seed) % BLIT_TEXT_NARROW);
+    g->height = 1 + (int)(lcg(&seed) % 20U);
+    g->x_atlas = (int)(lcg(&seed) % (unsigned int)(atlas.width - g->width + 1));
+    g->y_atlas = (int)(lcg(&seed) % (unsigned int)(atlas.height - g->height + 1));
+    if (index % 11 == 0) {
+      g->x_atlas = index & 1 ? atlas.width - g->width / 2 : -g->width / 2;
+      g->y_atlas = index & 2 ? atlas.height - g->height / 2 : -g->height / 2;
+    }
+    g->x_offset = (int)(lcg(&seed) % 5U) - 2;
+    g->y_offset = (int)(lcg(&seed) % 9U) - 4;
+    g->advance = g->width + (int)(lcg(&seed) % 3U);
+  }
+  struct blit_font font = {
+      .atlas = &atlas,
+      .glyph = glyph,
+      .first = 32,
+      .count = 96,
+  };
+  assert(blit_font_shift_count(&font) <= sizeof(shifted) / sizeof(shifted[0]));
+
+  /*
+   * Runs against glyph-by-glyph blits, partly off every edge, with and without
+   * the pre-shifted cache.
+   */
+  char text[40];
+  for (int i = 0; i < 1000; i++) {
+    if (i == 500)
+      blit_font_shift(&font, shifted);
+    for (size_t j = 0; j < size; j++)
+      image.store[j] = expected.store[j] = (blit_scanline_t)lcg(&seed);
+
+    const enum blit_rop2 rop2 = (enum blit_rop2)(i & 15);
+    const int length = (int)(lcg(&seed) % sizeof(text));
+    for (int k = 0; k < length; k++)
+      text[k] = (char)(28 + lcg(&seed) % 104U);
+    const int x = (int)(lcg(&seed) % 400U) - 100, y = (int)(lcg(&seed) % 80U) - 10;
+
+    int pen = x;
+    for (int k = 0; k < length; k++) {
+      const int index = (unsigned char)text[k] - font.first;
+      if (index < 0 || index >= font.count)
+        continue;
+      const struct blit_glyph *g = glyph + index;
+      (void)blit_rop2(&expected, pen + g->x_offset, y + g->y_offset, g->width, g->height, &atlas, g->x_atlas, g->y_atlas, rop2);
+      pen += g->advance;
+    }
+    assert(blit_text_width(&font, text, length) == pen - x);
+
+    struct blit_damage damage = {.count = 0};
+    image.damage = &damage;
+    (void)blit_text(&image, x, y, &font, text, length, rop2);
+    image.damage = NULL;
+    if (memcmp(image.store, expected.store, size) != 0) {
+      (void)printf("rop2=%d x=%d y=%d length=%d shifted=%d\n", rop2, x, y, length, font.shifted != NULL);
+      return EXIT_FAILURE;
+    }
+    assert(damage.count <= 1);
+    if (rop2 == blit_rop2_D && damage.count != 0)
+      return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,87 @@
+#include <blit/tile.h>
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+static int mod(int a, int m) { return ((a % m) + m) % m; }
+
+int test_tile() {
+  blit_scanline_t pat_store[] = {0x40U, 0x80U};
+  struct blit_scan pat = {
+      .store = pat_store,
+      .width = 2,
+      .height = 2,
+      .stride = 1,
+  };
+  BLIT_SCAN_DEFINE(image, 8, 8);
+  BLIT_SCAN_DEFINE_STATIC(canvas, 4500, 24);
+  BLIT_SCAN_DEFINE_STATIC(expected, 4500, 24);
+  BLIT_SCAN_DEFINE_STATIC(pattern_store, 40, 12);
+  const size_t size = (size_t)(canvas.stride * canvas.height);
+  unsigned int seed = 5U;
+
+  /*
+   * One call tiles the checkerboard that the pattern test builds one tile at a
+   * time.
+   */
+  if (blit_tile(&image, 0, 0, image.width, image.height, &pat, 0, 0, blit_rop2_copy) != 8)
+    return EXIT_FAILURE;
+  for (int y = 0; y < image.height; y++)
+    for (int x = 0; x < image.width; x++)
+      assert(bit_get(&image, x, y) == ((x & 1) ^ (y & 1)));
+
+  /*
+   * Random operations, rectangles, patterns and pattern origins, some regions
+   * wider than a chunk, against the truth table.
+   */
+  for (int i = 0; i < 400; i++) {
+    for (size_t j = 0; j < size; j++)
+      canvas.store[j] = expected.store[j] = (blit_scanline_t)lcg(&seed);
+    for (size_t j = 0; j < sizeof(pattern_store_store); j++)
+      pattern_store.store[j] = (blit_scanline_t)lcg(&seed);
+
+    const enum blit_rop2 rop2 = (enum blit_rop2)(i & 15);
+    struct blit_scan pattern = pattern_store;
+    pattern.width = (i & 16) ? 8 : 1 + (int)(lcg(&seed) % 40U);
+    pattern.height = (i & 16) ? 8 : 1 + (int)(lcg(&seed) % 12U);
+    const int x_pattern = (int)(lcg(&seed) % 100U) - 50, y_pattern = (int)(lcg(&seed) % 100U) - 50;
+    const int x_extent = 1 + (int)(lcg(&seed) % ((i & 32) ? 4500U : 200U));
+    const int y_extent = 1 + (int)(lcg(&seed) % 24U);
+    const int x = (int)(lcg(&seed) % (unsigned int)(canvas.width - x_extent + 1));
+    const int y = (int)(lcg(&seed) % (unsigned int)(canvas.height - y_extent + 1));
+
+    const int logic_count = blit_tile(&canvas, x, y, x_extent, y_extent, &pattern, x_pattern, y_pattern, rop2);
+    if (logic_count != y_extent * (((x + x_extent - 1) >> 3) - (x >> 3) + 1))
+      return EXIT_FAILURE;
+    for (int v = 0; v < canvas.height; v++) {
+      for (int u = 0; u < canvas.width; u++) {
+        int bit = bit_get(&expected, u, v);
+        if (u >= x && u < x + x_extent && v >= y && v < y + y_extent)
+          bit = (rop2 >> (2 * bit_get(&pattern, mod(u - x_pattern, pattern.width), mod(v - y_pattern, pattern.height)) + bit)) & 1;
+        if (bit != bit_get(&canvas, u, v)) {
+          (void)printf("rop2=%d x=%d y=%d x_extent=%d y_extent=%d at %d,%d\n", rop2, x, y, x_extent, y_extent, u, v);
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  /*
+   * Empty patterns tile nothing.
+   */
+  struct blit_scan empty = pat;
+  empty.width = 0;
+  (void)memcpy(expected.store, canvas.store, size);
+  if (blit_tile(&canvas, 0, 0, 64, 8, &empty, 0, 0, blit_rop2_copy) != 0)
+    return EXIT_FAILURE;
+  empty.width = 2;
+  empty.height = 0;
+  if (blit_tile(&canvas, 0, 0, 64, 8, &empty, 0, 0, blit_rop2_copy) != 0 || memcmp(expected.store, canvas.store, size) != 0)
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,51 @@
+#include <blit/rop2.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fixture.h"
+
+int test_word_span() {
+  BLIT_SCAN_DEFINE_STATIC(result, 400, 6);
+  BLIT_SCAN_DEFINE_STATIC(expected, 400, 6);
+  BLIT_SCAN_DEFINE_STATIC(source, 400, 6);
+  unsigned int seed = 1U;
+
+  for (int i = 0; i < 4000; i++) {
+    for (int j = 0; j < source.stride * source.height; j++) {
+      source.store[j] = (blit_scanline_t)lcg(&seed);
+      result.store[j] = (blit_scanline_t)lcg(&seed);
+    }
+    (void)memcpy(expected.store, result.store, (size_t)(result.stride * result.height));
+
+    const enum blit_rop2 rop2 = (enum blit_rop2)(i & 15);
+    const int x = (int)(lcg(&seed) % 64U);
+    const int x_source = (int)(lcg(&seed) % 64U);
+    const int x_extent = 1 + (int)(lcg(&seed) % 336U);
+    const int y = (int)(lcg(&seed) % 3U);
+    const int y_source = (int)(lcg(&seed) % 3U);
+    const int y_extent = 1 + (int)(lcg(&seed) % 3U);
+
+    /*
+     * Apply the raster operation bit by bit using the truth table encoded in
+     * the operation code: bit (2S + D) of the code gives the result.
+     */
+    for (int v = 0; v < y_extent; v++) {
+      for (int u = 0; u < x_extent; u++) {
+        const int s = bit_get(&source, x_source + u, y_source + v);
+        const int d = bit_get(&expected, x + u, y + v);
+        bit_put(&expected, x + u, y + v, ((unsigned int)rop2 >> (2 * s + d)) & 1U);
+      }
+    }
+
+    const int x_max = x + x_extent - 1;
+    const int logic_count = blit_rop2(&result, x, y, x_extent, y_extent, &source, x_source, y_source, rop2);
+    if (logic_count != y_extent * ((x_max >> 3) - (x >> 3) + 1) || memcmp(expected.store, result.store, (size_t)(result.stride * result.height)) != 0) {
+      (void)printf("rop2=%d x=%d x_source=%d x_extent=%d\n", rop2, x, x_source, x_extent);
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}